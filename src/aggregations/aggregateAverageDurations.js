@@ -0,0 +1,122 @@
+'use strict'
+
+const constants = require('../constants/durations')
+
+// Runs on the daily histograms of durations. Buckets are stored as an object
+// with the bucket as key and the number of records as value. Returns the latest days
+// or all days of a custom range.
+module.exports = (id, range) => {
+
+	const aggregate = [
+		{
+			$match: {
+				domainId: id
+			}
+		},
+		{
+			$sort: {
+				day: -1
+			}
+		},
+		{
+			$limit: 14
+		},
+		{
+			$project: {
+				day: '$day',
+				bucket: {
+					$objectToArray: '$buckets'
+				}
+			}
+		},
+		{
+			$unwind: '$bucket'
+		},
+		{
+			$project: {
+				day: '$day',
+				bucket: {
+					$toInt: '$bucket.k'
+				},
+				count: '$bucket.v'
+			}
+		},
+		// Some visitors keep sites open in the background. Their duration is often
+		// way above the limit. This distorts the average and should be omitted.
+		{
+			$match: {
+				bucket: {
+					$lt: constants.DURATIONS_LIMIT / constants.DURATIONS_INTERVAL
+				}
+			}
+		},
+		// Visits below the tracking interval will have a duration of zero. That's
+		// incorrect as visitors spent time on the site, but just not enough. This
+		// step sets the minimum duration to the half of the tracking interval.
+		{
+			$group: {
+				_id: '$day',
+				duration: {
+					$sum: {
+						$multiply: [
+							{
+								$cond: {
+									if: {
+										$eq: [ '$bucket', 0 ]
+									},
+									then: constants.DURATIONS_INTERVAL / 2,
+									else: {
+										$multiply: [ '$bucket', constants.DURATIONS_INTERVAL ]
+									}
+								}
+							},
+							'$count'
+						]
+					}
+				},
+				count: {
+					$sum: '$count'
+				}
+			}
+		},
+		{
+			$match: {
+				count: {
+					$gt: 0
+				}
+			}
+		},
+		{
+			$project: {
+				_id: {
+					day: {
+						$mod: [ '$_id', 100 ]
+					},
+					month: {
+						$mod: [ { $floor: { $divide: [ '$_id', 100 ] } }, 100 ]
+					},
+					year: {
+						$floor: { $divide: [ '$_id', 10000 ] }
+					}
+				},
+				average: {
+					$divide: [ '$duration', '$count' ]
+				}
+			}
+		},
+		{
+			$sort: {
+				'_id.year': -1,
+				'_id.month': -1,
+				'_id.day': -1
+			}
+		}
+	]
+
+	if (range == null) return aggregate
+
+	aggregate[0].$match.day = { $gte: range.from, $lte: range.to }
+
+	return aggregate.filter((stage) => stage.$limit == null)
+
+}
\ No newline at end of file
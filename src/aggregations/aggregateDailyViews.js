@@ -1,48 +1,45 @@
 'use strict'
 
-module.exports = (id, unique) => {
+// Runs on the daily rollups of views and counts all views. Days are stored as yyyymmdd.
+// Returns the latest periods or all periods of a custom range.
+module.exports = (id, range) => {
 
-	const aggregation = [
+	const aggregate = [
 		{
 			$match: {
 				domainId: id
 			}
 		},
 		{
-			$group: {
+			$sort: {
+				day: -1
+			}
+		},
+		{
+			$limit: 14
+		},
+		{
+			$project: {
 				_id: {
 					day: {
-						$dayOfMonth: '$created'
+						$mod: [ '$day', 100 ]
 					},
 					month: {
-						$month: '$created'
+						$mod: [ { $floor: { $divide: [ '$day', 100 ] } }, 100 ]
 					},
 					year: {
-						$year: '$created'
+						$floor: { $divide: [ '$day', 10000 ] }
 					}
 				},
-				count: {
-					$sum: 1
-				}
+				count: '$total'
 			}
-		},
-		{
-			$sort: {
-				'_id.year': -1,
-				'_id.month': -1,
-				'_id.day': -1
-			}
-		},
-		{
-			$limit: 14
 		}
 	]
 
-	if (unique === true) aggregation[0].$match.clientId = {
-		$exists: true,
-		$ne: null
-	}
+	if (range == null) return aggregate
+
+	aggregate[0].$match.day = { $gte: range.from, $lte: range.to }
 
-	return aggregation
+	return aggregate.filter((stage) => stage.$limit == null)
 
 }
\ No newline at end of file
@@ -0,0 +1,98 @@
+'use strict'
+
+const constants = require('../constants/durations')
+
+// Runs on the daily histograms of durations and returns the average and the
+// number of records per bucket in a single pass. Days are stored as yyyymmdd and `to` is optional.
+module.exports = (id, day, to) => [
+	{
+		$match: {
+			domainId: id,
+			day: to == null ? { $gte: day } : { $gte: day, $lte: to }
+		}
+	},
+	{
+		$project: {
+			bucket: {
+				$objectToArray: '$buckets'
+			}
+		}
+	},
+	{
+		$unwind: '$bucket'
+	},
+	{
+		$project: {
+			bucket: {
+				$toInt: '$bucket.k'
+			},
+			count: '$bucket.v'
+		}
+	},
+	{
+		$facet: {
+			// Same rules as the average durations: Omit durations above the limit
+			// and use half of the tracking interval for durations below it.
+			average: [
+				{
+					$match: {
+						bucket: {
+							$lt: constants.DURATIONS_LIMIT / constants.DURATIONS_INTERVAL
+						}
+					}
+				},
+				{
+					$group: {
+						_id: null,
+						duration: {
+							$sum: {
+								$multiply: [
+									{
+										$cond: {
+											if: {
+												$eq: [ '$bucket', 0 ]
+											},
+											then: constants.DURATIONS_INTERVAL / 2,
+											else: {
+												$multiply: [ '$bucket', constants.DURATIONS_INTERVAL ]
+											}
+										}
+									},
+									'$count'
+								]
+							}
+						},
+						count: {
+							$sum: '$count'
+						}
+					}
+				}
+			],
+			// The last bucket contains all durations above the limit
+			detailed: [
+				{
+					$group: {
+						_id: {
+							$multiply: [ '$bucket', constants.DURATIONS_INTERVAL ]
+						},
+						count: {
+							$sum: '$count'
+						}
+					}
+				},
+				{
+					$match: {
+						count: {
+							$gt: 0
+						}
+					}
+				},
+				{
+					$sort: {
+						_id: 1
+					}
+				}
+			]
+		}
+	}
+]
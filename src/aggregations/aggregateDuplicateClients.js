@@ -0,0 +1,37 @@
+'use strict'
+
+// Returns the latest record of each visitor that still has previous records with its clientId.
+// Only records that haven't been anonymized are included in the index of clientId.
+module.exports = () => [
+	{
+		$match: {
+			clientId: {
+				$exists: true
+			}
+		}
+	},
+	{
+		$sort: {
+			clientId: 1,
+			created: -1
+		}
+	},
+	{
+		$group: {
+			_id: '$clientId',
+			latestId: {
+				$first: '$id'
+			},
+			count: {
+				$sum: 1
+			}
+		}
+	},
+	{
+		$match: {
+			count: {
+				$gt: 1
+			}
+		}
+	}
+]
\ No newline at end of file
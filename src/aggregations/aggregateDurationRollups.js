@@ -0,0 +1,61 @@
+'use strict'
+
+const constants = require('../constants/durations')
+const dayKeyExpression = require('../utils/dayKeyExpression')
+
+// Builds the daily histograms of durations from all records. Matches the
+// buckets of utils/durationBucket.
+module.exports = () => [
+	{
+		$project: {
+			domainId: '$domainId',
+			day: dayKeyExpression(),
+			bucket: {
+				$min: [
+					{
+						$floor: {
+							$divide: [ { $subtract: [ '$updated', '$created' ] }, constants.DURATIONS_INTERVAL ]
+						}
+					},
+					constants.DURATIONS_LIMIT / constants.DURATIONS_INTERVAL
+				]
+			}
+		}
+	},
+	{
+		$group: {
+			_id: {
+				domainId: '$domainId',
+				day: '$day',
+				bucket: '$bucket'
+			},
+			count: {
+				$sum: 1
+			}
+		}
+	},
+	{
+		$group: {
+			_id: {
+				domainId: '$_id.domainId',
+				day: '$_id.day'
+			},
+			buckets: {
+				$push: {
+					k: { $toString: { $toInt: '$_id.bucket' } },
+					v: '$count'
+				}
+			}
+		}
+	},
+	{
+		$project: {
+			_id: 0,
+			domainId: '$_id.domainId',
+			day: '$_id.day',
+			buckets: {
+				$arrayToObject: '$buckets'
+			}
+		}
+	}
+]
@@ -0,0 +1,20 @@
+'use strict'
+
+// Runs on the heartbeats of records in time-series collections and returns the latest update of each record
+module.exports = (ids) => [
+	{
+		$match: {
+			recordId: {
+				$in: ids
+			}
+		}
+	},
+	{
+		$group: {
+			_id: '$recordId',
+			updated: {
+				$max: '$updated'
+			}
+		}
+	}
+]
\ No newline at end of file
@@ -5,6 +5,7 @@ module.exports = (id, property) => [
 		$match: {
 			domainId: id,
 			[property]: {
+				$exists: true,
 				$ne: null
 			}
 		}
@@ -25,7 +25,7 @@ module.exports = (id, properties) => {
 	]
 
 	properties.forEach((property) => {
-		aggregate[0].$match[property] = { $ne: null }
+		aggregate[0].$match[property] = { $exists: true, $ne: null }
 		aggregate[2].$project._id[property] = `$${ property }`
 	})
 
@@ -0,0 +1,26 @@
+'use strict'
+
+// Runs on records in time-series collections and sets their `updated` to their latest heartbeat.
+// `from` is the name of the collection of the heartbeats.
+module.exports = (from) => [
+	{
+		$lookup: {
+			from,
+			localField: 'id',
+			foreignField: 'recordId',
+			as: 'heartbeats'
+		}
+	},
+	{
+		$addFields: {
+			updated: {
+				$max: [ '$updated', { $max: '$heartbeats.updated' } ]
+			}
+		}
+	},
+	{
+		$project: {
+			heartbeats: 0
+		}
+	}
+]
\ No newline at end of file
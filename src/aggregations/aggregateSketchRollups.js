@@ -0,0 +1,66 @@
+'use strict'
+
+const dayKeyExpression = require('../utils/dayKeyExpression')
+
+// Builds the daily summaries of a dimension from all records. Only the
+// `size` most frequent values of each day are kept.
+module.exports = (properties, size) => {
+
+	const aggregate = [
+		{
+			$match: {}
+		},
+		{
+			$group: {
+				_id: {
+					domainId: '$domainId',
+					day: dayKeyExpression(),
+					value: properties.length === 1 ? `$${ properties[0] }` : {}
+				},
+				count: {
+					$sum: 1
+				}
+			}
+		},
+		{
+			$sort: {
+				count: -1
+			}
+		},
+		{
+			$group: {
+				_id: {
+					domainId: '$_id.domainId',
+					day: '$_id.day'
+				},
+				counters: {
+					$push: {
+						value: '$_id.value',
+						count: '$count',
+						error: 0
+					}
+				}
+			}
+		},
+		{
+			$project: {
+				_id: 0,
+				domainId: '$_id.domainId',
+				day: '$_id.day',
+				dimension: properties.join(','),
+				counters: {
+					$slice: [ '$counters', size ]
+				},
+				version: 0
+			}
+		}
+	]
+
+	properties.forEach((property) => {
+		aggregate[0].$match[property] = { $exists: true, $ne: null }
+		if (properties.length > 1) aggregate[1].$group._id.value[property] = `$${ property }`
+	})
+
+	return aggregate
+
+}
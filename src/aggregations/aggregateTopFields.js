@@ -1,14 +1,16 @@
 'use strict'
 
-const offsetByRange = require('../utils/offsetByRange')
+const createdByRange = require('../utils/createdByRange')
 
-module.exports = (id, property, range) => {
+module.exports = (id, property, range, sample) => {
 
 	const aggregate = [
 		{
+			// The redundant $exists lets MongoDB pick the partial index of the property
 			$match: {
 				domainId: id,
 				[property]: {
+					$exists: true,
 					$ne: null
 				}
 			}
@@ -31,9 +33,21 @@ module.exports = (id, property, range) => {
 		}
 	]
 
-	const dateOffset = offsetByRange(range)
-	if (dateOffset != null) {
-		aggregate[0].$match.created = { $gte: dateOffset }
+	const created = createdByRange(range)
+	if (created != null) {
+		aggregate[0].$match.created = created
+	}
+
+	// Counts of the sample are scaled to the number of all records. Scaled counts are
+	// multiples of the scale, e.g. 20 for a value that is part of a 5 % sample once.
+	if (sample != null) {
+		aggregate[0].$match.id = { $lt: sample.threshold }
+		aggregate.push({
+			$addFields: {
+				count: { $round: [ { $multiply: [ '$count', sample.scale ] }, 0 ] },
+				estimated: true
+			}
+		})
 	}
 
 	return aggregate
@@ -1,8 +1,8 @@
 'use strict'
 
-const offsetByRange = require('../utils/offsetByRange')
+const createdByRange = require('../utils/createdByRange')
 
-module.exports = (id, properties, range) => {
+module.exports = (id, properties, range, sample) => {
 
 	const aggregate = [
 		{
@@ -29,13 +29,25 @@ module.exports = (id, properties, range) => {
 	]
 
 	properties.forEach((property) => {
-		aggregate[0].$match[property] = { $ne: null }
+		aggregate[0].$match[property] = { $exists: true, $ne: null }
 		aggregate[1].$group._id[property] = `$${ property }`
 	})
 
-	const dateOffset = offsetByRange(range)
-	if (dateOffset != null) {
-		aggregate[0].$match.created = { $gte: dateOffset }
+	const created = createdByRange(range)
+	if (created != null) {
+		aggregate[0].$match.created = created
+	}
+
+	// Counts of the sample are scaled to the number of all records. Scaled counts are
+	// multiples of the scale, e.g. 20 for a value that is part of a 5 % sample once.
+	if (sample != null) {
+		aggregate[0].$match.id = { $lt: sample.threshold }
+		aggregate.push({
+			$addFields: {
+				count: { $round: [ { $multiply: [ '$count', sample.scale ] }, 0 ] },
+				estimated: true
+			}
+		})
 	}
 
 	return aggregate
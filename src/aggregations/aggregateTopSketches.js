@@ -0,0 +1,70 @@
+'use strict'
+
+const dayRange = require('../utils/dayRange')
+const dayIndex = require('../utils/dayIndex')
+const dyadicBlocks = require('../utils/dyadicBlocks')
+
+// Runs on the summaries of a dimension. Counts of the same value are summed up across
+// the fewest summaries of days and blocks of days that cover the range, including the
+// values that haven't been merged into the counters yet.
+module.exports = (id, dimension, range) => {
+
+	const { from, to } = dayRange(range)
+
+	// Summaries of the same level are matched with one condition
+	const levels = dyadicBlocks(dayIndex(from), dayIndex(to)).reduce((acc, block) => {
+		acc[block.level] = [ ...(acc[block.level] || []), dayIndex.toDayKey(block.start) ]
+		return acc
+	}, {})
+
+	const aggregate = [
+		{
+			$match: {
+				domainId: id,
+				dimension,
+				$or: Object.keys(levels).map((level) => ({
+					level: Number.parseInt(level),
+					day: {
+						$in: levels[level]
+					}
+				}))
+			}
+		},
+		{
+			$project: {
+				counters: {
+					$concatArrays: [ '$counters', { $ifNull: [ '$pending', [] ] } ]
+				}
+			}
+		},
+		{
+			$unwind: '$counters'
+		},
+		{
+			$group: {
+				_id: '$counters.value',
+				count: {
+					$sum: '$counters.count'
+				}
+			}
+		},
+		{
+			$match: {
+				count: {
+					$gt: 0
+				}
+			}
+		},
+		{
+			$sort: {
+				count: -1
+			}
+		},
+		{
+			$limit: 30
+		}
+	]
+
+	return aggregate
+
+}
@@ -0,0 +1,82 @@
+'use strict'
+
+const constants = require('../constants/views')
+const periodExpression = require('../utils/periodExpression')
+
+// Runs on the daily rollups of views and merges the HyperLogLog registers of each period.
+// Returns the inputs of utils/hyperLogLog#estimate instead of the count. Returns the latest
+// periods or all periods of a custom range.
+module.exports = (id, interval, range) => {
+
+	const period = periodExpression(interval)
+
+	const aggregate = [
+		{
+			$match: {
+				domainId: id
+			}
+		},
+		{
+			$project: {
+				day: '$day',
+				register: {
+					$objectToArray: { $ifNull: [ '$hll', {} ] }
+				}
+			}
+		},
+		{
+			$unwind: {
+				path: '$register',
+				preserveNullAndEmptyArrays: true
+			}
+		},
+		{
+			$group: {
+				_id: {
+					period,
+					index: '$register.k'
+				},
+				rank: {
+					$max: '$register.v'
+				}
+			}
+		},
+		{
+			$group: {
+				_id: '$_id.period',
+				sum: {
+					$sum: {
+						$pow: [ 2, { $multiply: [ -1, '$rank' ] } ]
+					}
+				},
+				registers: {
+					$sum: {
+						$cond: [ { $ifNull: [ '$rank', false ] }, 1, 0 ]
+					}
+				}
+			}
+		},
+		{
+			$sort: Object.keys(period).reverse().reduce((acc, key) => {
+				acc[`_id.${ key }`] = -1
+				return acc
+			}, {})
+		},
+		{
+			$limit: 14
+		}
+	]
+
+	if (range != null) {
+		aggregate[0].$match.day = { $gte: range.from, $lte: range.to }
+		return aggregate.filter((stage) => stage.$limit == null)
+	}
+
+	// Only the latest days are needed and the registers of older ones don't need to be merged
+	if (interval === constants.VIEWS_INTERVAL_DAILY) {
+		aggregate.splice(1, 0, { $sort: { day: -1 } }, { $limit: 14 })
+	}
+
+	return aggregate
+
+}
@@ -0,0 +1,76 @@
+'use strict'
+
+const periodExpression = require('../utils/periodExpression')
+
+// Runs on the daily rollups of views and merges the HyperLogLog registers of each domain and
+// period in one pass. Returns the inputs of utils/hyperLogLog#estimate instead of the count.
+module.exports = (ids, interval, range) => {
+
+	const period = periodExpression(interval)
+
+	return [
+		{
+			$match: {
+				domainId: {
+					$in: ids
+				},
+				day: {
+					$gte: range.from,
+					$lte: range.to
+				}
+			}
+		},
+		{
+			$project: {
+				domainId: '$domainId',
+				day: '$day',
+				register: {
+					$objectToArray: { $ifNull: [ '$hll', {} ] }
+				}
+			}
+		},
+		{
+			$unwind: {
+				path: '$register',
+				preserveNullAndEmptyArrays: true
+			}
+		},
+		{
+			$group: {
+				_id: {
+					domainId: '$domainId',
+					period,
+					index: '$register.k'
+				},
+				rank: {
+					$max: '$register.v'
+				}
+			}
+		},
+		{
+			$group: {
+				_id: {
+					domainId: '$_id.domainId',
+					period: '$_id.period'
+				},
+				sum: {
+					$sum: {
+						$pow: [ 2, { $multiply: [ -1, '$rank' ] } ]
+					}
+				},
+				registers: {
+					$sum: {
+						$cond: [ { $ifNull: [ '$rank', false ] }, 1, 0 ]
+					}
+				}
+			}
+		},
+		{
+			$sort: Object.keys(period).reverse().reduce((acc, key) => {
+				acc[`_id.period.${ key }`] = -1
+				return acc
+			}, {})
+		}
+	]
+
+}
\ No newline at end of file
@@ -0,0 +1,30 @@
+'use strict'
+
+const dayKeyExpression = require('../utils/dayKeyExpression')
+
+// Builds the daily rollups of views from all records. The HyperLogLog registers
+// are built separately as they can't be computed from the hex hashes in MongoDB.
+module.exports = () => [
+	{
+		$group: {
+			_id: {
+				domainId: '$domainId',
+				day: dayKeyExpression()
+			},
+			total: {
+				$sum: 1
+			}
+		}
+	},
+	{
+		$project: {
+			_id: 0,
+			domainId: '$_id.domainId',
+			day: '$_id.day',
+			total: '$total',
+			hll: {
+				$literal: {}
+			}
+		}
+	}
+]
@@ -0,0 +1,42 @@
+'use strict'
+
+const periodExpression = require('../utils/periodExpression')
+
+// Runs on the daily rollups of views and counts all views of multiple domains per day, month
+// or year in one pass. Days of the range are stored as yyyymmdd.
+module.exports = (ids, interval, range) => {
+
+	const period = periodExpression(interval)
+
+	return [
+		{
+			$match: {
+				domainId: {
+					$in: ids
+				},
+				day: {
+					$gte: range.from,
+					$lte: range.to
+				}
+			}
+		},
+		{
+			$group: {
+				_id: {
+					domainId: '$domainId',
+					period
+				},
+				count: {
+					$sum: '$total'
+				}
+			}
+		},
+		{
+			$sort: Object.keys(period).reverse().reduce((acc, key) => {
+				acc[`_id.period.${ key }`] = -1
+				return acc
+			}, {})
+		}
+	]
+
+}
\ No newline at end of file
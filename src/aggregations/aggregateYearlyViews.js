@@ -1,8 +1,10 @@
 'use strict'
 
-module.exports = (id, unique) => {
+// Runs on the daily rollups of views and counts all views. Days are stored as yyyymmdd.
+// Returns the latest periods or all periods of a custom range.
+module.exports = (id, range) => {
 
-	const aggregation = [
+	const aggregate = [
 		{
 			$match: {
 				domainId: id
@@ -12,17 +14,17 @@ module.exports = (id, unique) => {
 			$group: {
 				_id: {
 					year: {
-						$year: '$created'
+						$floor: { $divide: [ '$day', 10000 ] }
 					}
 				},
 				count: {
-					$sum: 1
+					$sum: '$total'
 				}
 			}
 		},
 		{
 			$sort: {
-				'_id.day': -1
+				'_id.year': -1
 			}
 		},
 		{
@@ -30,11 +32,10 @@ module.exports = (id, unique) => {
 		}
 	]
 
-	if (unique === true) aggregation[0].$match.clientId = {
-		$exists: true,
-		$ne: null
-	}
+	if (range == null) return aggregate
 
-	return aggregation
+	aggregate[0].$match.day = { $gte: range.from, $lte: range.to }
+
+	return aggregate.filter((stage) => stage.$limit == null)
 
 }
\ No newline at end of file
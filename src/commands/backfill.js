@@ -0,0 +1,57 @@
+#!/usr/bin/env node
+'use strict'
+
+require('dotenv').config()
+
+const mongoose = require('mongoose')
+
+const signale = require('../utils/signale')
+const connect = require('../utils/connect')
+const stripUrlAuth = require('../utils/stripUrlAuth')
+const records = require('../database/records')
+const views = require('../database/views')
+const durations = require('../database/durations')
+const sketches = require('../database/sketches')
+
+const dbUrl = process.env.ACKEE_MONGODB || process.env.MONGODB_URI
+
+if (dbUrl == null) {
+	signale.fatal('MongoDB connection URI missing in environment')
+	process.exit(1)
+}
+
+signale.await(`Connecting to ${ stripUrlAuth(dbUrl) }`)
+
+connect(dbUrl).then(async () => {
+
+	signale.success(`Connected to ${ stripUrlAuth(dbUrl) }`)
+
+	// Rollups group records by their stored day
+	signale.await('Updating days and dimensions of records')
+	const recordCount = await records.backfill()
+	signale.success(`Updated ${ recordCount } records`)
+
+	signale.await('Building views from records')
+	const viewCount = await views.backfill()
+	signale.success(`Built ${ viewCount } daily views`)
+
+	signale.await('Building durations from records')
+	const durationCount = await durations.backfill()
+	signale.success(`Built ${ durationCount } daily durations`)
+
+	if (sketches.enabled === true) {
+		signale.await('Migrating summaries of top values')
+		await sketches.migrate()
+		signale.await('Building top values from records')
+		const sketchCount = await sketches.backfill()
+		signale.success(`Built ${ sketchCount } daily summaries of top values`)
+	}
+
+	await mongoose.disconnect()
+
+}).catch((err) => {
+
+	signale.fatal(err)
+	process.exit(1)
+
+})
@@ -0,0 +1,332 @@
+#!/usr/bin/env node
+'use strict'
+
+require('dotenv').config()
+
+const crypto = require('crypto')
+const { readFile, writeFile } = require('fs').promises
+const mongoose = require('mongoose')
+const uuid = require('uuid').v4
+
+const Record = require('../schemas/Record')
+const Domain = require('../schemas/Domain')
+const View = require('../schemas/View')
+const Duration = require('../schemas/Duration')
+const Sketch = require('../schemas/Sketch')
+const views = require('../database/views')
+const durations = require('../database/durations')
+const sketches = require('../database/sketches')
+const aggregateTopFields = require('../aggregations/aggregateTopFields')
+const aggregateTopFieldsMultiple = require('../aggregations/aggregateTopFieldsMultiple')
+const aggregateRecentFields = require('../aggregations/aggregateRecentFields')
+const aggregateRecentFieldsMultiple = require('../aggregations/aggregateRecentFieldsMultiple')
+const aggregateNewFields = require('../aggregations/aggregateNewFields')
+const aggregateDailyViews = require('../aggregations/aggregateDailyViews')
+const aggregateMonthlyViews = require('../aggregations/aggregateMonthlyViews')
+const aggregateYearlyViews = require('../aggregations/aggregateYearlyViews')
+const aggregateUniqueViews = require('../aggregations/aggregateUniqueViews')
+const aggregateAverageDurations = require('../aggregations/aggregateAverageDurations')
+const aggregateDetailedDurations = require('../aggregations/aggregateDetailedDurations')
+const aggregateTopSketches = require('../aggregations/aggregateTopSketches')
+const aggregateViewRollups = require('../aggregations/aggregateViewRollups')
+const aggregateDurationRollups = require('../aggregations/aggregateDurationRollups')
+const aggregateSketchRollups = require('../aggregations/aggregateSketchRollups')
+const ranges = require('../constants/ranges')
+const accuracies = require('../constants/accuracies')
+const viewsConstants = require('../constants/views')
+const signale = require('../utils/signale')
+const connect = require('../utils/connect')
+const stripUrlAuth = require('../utils/stripUrlAuth')
+const parseArgs = require('../utils/parseArgs')
+const explainStats = require('../utils/explainStats')
+const percentile = require('../utils/percentile')
+const sampling = require('../utils/sampling')
+const randomInt = require('../utils/randomInt')
+const randomItem = require('../utils/randomItem')
+const dayKey = require('../utils/dayKey')
+const dayIndex = require('../utils/dayIndex')
+const { createRecord } = require('../utils/fillDatabase')
+const { minute, hour, day } = require('../utils/times')
+
+const args = parseArgs(process.argv.slice(2))
+
+const options = {
+	sizes: (args.sizes || '1000000').split(',').map((size) => Number.parseInt(size)),
+	domains: Number.parseInt(args.domains) || 10,
+	runs: Number.parseInt(args.runs) || 3,
+	baseline: args.baseline,
+	output: args.output,
+	docsTolerance: args['docs-tolerance'] == null ? 0.1 : Number.parseFloat(args['docs-tolerance']),
+	latencyTolerance: args['latency-tolerance'] == null ? 0.5 : Number.parseFloat(args['latency-tolerance'])
+}
+
+// The benchmark adds millions of records and must never run against the database of an installation
+const dbUrl = process.env.ACKEE_BENCH_MONGODB
+
+if (dbUrl == null) {
+	signale.fatal('MongoDB connection URI of the benchmark database missing in `ACKEE_BENCH_MONGODB`')
+	process.exit(1)
+}
+
+const allRanges = [
+	ranges.RANGES_LAST_24_HOURS,
+	ranges.RANGES_LAST_7_DAYS,
+	ranges.RANGES_LAST_30_DAYS,
+	ranges.RANGES_ALL_TIME
+]
+
+const topProperties = [ 'siteLocation', 'siteReferrer', 'siteLanguage', 'screenWidth', 'browserWidth', 'deviceManufacturer', 'osName', 'browserName' ]
+const multipleProperties = [ [ 'screenWidth', 'screenHeight' ], [ 'deviceManufacturer', 'deviceName' ], [ 'osName', 'osVersion' ], [ 'browserName', 'browserVersion' ] ]
+
+const intervals = [
+	[ viewsConstants.VIEWS_INTERVAL_DAILY, aggregateDailyViews ],
+	[ viewsConstants.VIEWS_INTERVAL_MONTHLY, aggregateMonthlyViews ],
+	[ viewsConstants.VIEWS_INTERVAL_YEARLY, aggregateYearlyViews ]
+]
+
+// Pipelines are built for every run as aggregations may modify them
+const createCases = (id) => {
+
+	const cases = []
+	const add = (name, model, build, allowDiskUse = false) => cases.push({ name, model, build, allowDiskUse })
+
+	topProperties.forEach((property) => allRanges.forEach((range) => {
+		add(`aggregateTopFields ${ property } ${ range }`, Record, () => aggregateTopFields(id, property, range))
+	}))
+
+	topProperties.forEach((property) => {
+		add(`aggregateTopFields ${ property } ${ ranges.RANGES_ALL_TIME } approx`, Record, () => aggregateTopFields(id, property, ranges.RANGES_ALL_TIME, sampling(accuracies.ACCURACIES_APPROXIMATE)))
+	})
+
+	multipleProperties.forEach((properties) => allRanges.forEach((range) => {
+		add(`aggregateTopFieldsMultiple ${ properties.join(',') } ${ range }`, Record, () => aggregateTopFieldsMultiple(id, properties, range))
+	}))
+
+	topProperties.forEach((property) => {
+		add(`aggregateRecentFields ${ property }`, Record, () => aggregateRecentFields(id, property))
+	})
+
+	multipleProperties.forEach((properties) => {
+		add(`aggregateRecentFieldsMultiple ${ properties.join(',') }`, Record, () => aggregateRecentFieldsMultiple(id, properties))
+	})
+
+	add('aggregateNewFields siteReferrer', Record, () => aggregateNewFields(id, 'siteReferrer'))
+
+	intervals.forEach(([ interval, aggregateViews ]) => {
+		add(`aggregateViews ${ interval }`, View, () => aggregateViews(id))
+		add(`aggregateUniqueViews ${ interval }`, View, () => aggregateUniqueViews(id, interval))
+	})
+
+	add('aggregateAverageDurations', Duration, () => aggregateAverageDurations(id))
+	add('aggregateDetailedDurations', Duration, () => aggregateDetailedDurations(id, dayIndex.toDayKey(dayIndex(dayKey()) - 6)))
+
+	allRanges.forEach((range) => {
+		add(`aggregateTopSketches siteLocation ${ range }`, Sketch, () => aggregateTopSketches(id, 'siteLocation', range))
+	})
+
+	// Rollups are built for a single domain like when records are removed by the retention
+	add('aggregateViewRollups', Record, () => [ { $match: { domainId: id } }, ...aggregateViewRollups() ], true)
+	add('aggregateDurationRollups', Record, () => [ { $match: { domainId: id } }, ...aggregateDurationRollups() ], true)
+	add('aggregateSketchRollups siteLocation', Record, () => [ { $match: { domainId: id } }, ...aggregateSketchRollups([ 'siteLocation' ], 500) ], true)
+
+	return cases
+
+}
+
+// Records are spread over the last year. Only some of them keep their clientId like after the anonymization.
+const createDocument = (domainIds) => {
+
+	const created = new Date(Date.now() - randomInt(0, day * 365))
+	const duration = Math.random() < 0.8 ? randomInt(0, minute * 2) : randomInt(0, hour)
+
+	const document = {
+		id: uuid(),
+		domainId: randomItem(domainIds),
+		...createRecord(),
+		created,
+		updated: new Date(created.getTime() + duration),
+		day: dayKey(created)
+	}
+
+	if (Math.random() < 0.3) document.clientId = crypto.randomBytes(32).toString('hex')
+
+	return document
+
+}
+
+const seedDomains = async () => {
+
+	const entries = await Domain.find().limit(options.domains).lean()
+
+	for (let i = entries.length; i < options.domains; i++) {
+		entries.push(await Domain.create({ title: `Benchmark ${ i + 1 }` }))
+	}
+
+	return entries.map((entry) => entry.id)
+
+}
+
+const seedRecords = async (size, domainIds) => {
+
+	let count = await Record.estimatedDocumentCount()
+
+	if (count >= size) return false
+
+	signale.await(`Adding ${ size - count } records`)
+
+	while (count < size) {
+
+		const batchSize = Math.min(10000, size - count)
+		const documents = Array.from({ length: batchSize }, () => createDocument(domainIds))
+
+		// Skips the validation of mongoose to seed millions of records quickly
+		await Record.collection.insertMany(documents, { ordered: false })
+		count += batchSize
+
+		if (count % 1000000 === 0) signale.info(`Added ${ count } records`)
+
+	}
+
+	return true
+
+}
+
+const measure = async (testCase) => {
+
+	const latencies = []
+
+	try {
+
+		for (let i = 0; i < options.runs; i++) {
+			const start = process.hrtime()
+			await testCase.model.aggregate(testCase.build()).allowDiskUse(testCase.allowDiskUse)
+			const [ seconds, nanoseconds ] = process.hrtime(start)
+			latencies.push(seconds * 1e3 + nanoseconds / 1e6)
+		}
+
+		const explain = await mongoose.connection.db.command({
+			explain: {
+				aggregate: testCase.model.collection.collectionName,
+				pipeline: testCase.build(),
+				allowDiskUse: testCase.allowDiskUse,
+				cursor: {}
+			},
+			verbosity: 'executionStats'
+		})
+
+		return {
+			latency: percentile(latencies.sort((a, b) => a - b), 50),
+			...explainStats(explain)
+		}
+
+	} catch (err) {
+
+		return {
+			error: err.message
+		}
+
+	}
+
+}
+
+// Returns the cases that examine more documents or take longer than in the baseline
+const compare = (results, baseline) => {
+
+	const failures = []
+
+	Object.keys(results).forEach((size) => {
+
+		if (baseline[size] == null) return
+
+		Object.keys(results[size]).forEach((name) => {
+
+			const current = results[size][name]
+			const previous = baseline[size][name]
+
+			if (previous == null || previous.error != null) return
+
+			if (current.error != null) return failures.push(`${ size } ${ name }: ${ current.error }`)
+
+			if (current.docsExamined > previous.docsExamined * (1 + options.docsTolerance)) {
+				failures.push(`${ size } ${ name }: examined ${ current.docsExamined } instead of ${ previous.docsExamined } documents`)
+			}
+
+			// Small absolute differences are noise
+			if (current.latency > previous.latency * (1 + options.latencyTolerance) && current.latency - previous.latency > 5) {
+				failures.push(`${ size } ${ name }: took ${ current.latency.toFixed(1) } ms instead of ${ previous.latency.toFixed(1) } ms`)
+			}
+
+		})
+
+	})
+
+	return failures
+
+}
+
+const bench = async () => {
+
+	signale.await(`Connecting to ${ stripUrlAuth(dbUrl) }`)
+	await connect(dbUrl)
+	await Record.init()
+
+	const domainIds = await seedDomains()
+	const results = {}
+
+	for (const size of options.sizes.sort((a, b) => a - b)) {
+
+		// Rollups are only rebuilt when records have been added
+		if (await seedRecords(size, domainIds) === true) {
+			signale.await('Building rollups')
+			await views.backfill()
+			await durations.backfill()
+			await sketches.backfill()
+		}
+
+		signale.start(`Measuring ${ size } records`)
+
+		results[size] = {}
+
+		for (const testCase of createCases(domainIds[0])) {
+
+			const result = await measure(testCase)
+			results[size][testCase.name] = result
+
+			if (result.error != null) {
+				signale.error(`${ testCase.name }: ${ result.error }`)
+				continue
+			}
+
+			const scan = result.collectionScan === true ? ', collection scan' : ''
+			const disk = result.usedDisk === true ? ', used disk' : ''
+			signale.info(`${ testCase.name }: ${ result.latency.toFixed(1) } ms, ${ result.docsExamined } docs examined, ${ result.indexes.join(' ') || 'no index' }${ scan }${ disk }`)
+
+		}
+
+	}
+
+	if (options.output != null) {
+		await writeFile(options.output, JSON.stringify(results, null, '\t'))
+		signale.success(`Saved results to ${ options.output }`)
+	}
+
+	await mongoose.disconnect()
+
+	if (options.baseline == null) return
+
+	const baseline = JSON.parse(await readFile(options.baseline, 'utf8'))
+	const failures = compare(results, baseline)
+
+	if (failures.length === 0) return signale.success('No regressions compared to the baseline')
+
+	failures.forEach((failure) => signale.error(failure))
+	process.exit(1)
+
+}
+
+bench().catch((err) => {
+
+	signale.fatal(err)
+	process.exit(1)
+
+})
@@ -0,0 +1,69 @@
+#!/usr/bin/env node
+'use strict'
+
+require('dotenv').config()
+
+const { resolve } = require('path')
+const { mkdir, writeFile } = require('fs').promises
+
+const signale = require('../utils/signale')
+const createAsset = require('../utils/createAsset')
+const assets = require('../ui/assets')
+
+const distPath = resolve(__dirname, '../../dist')
+
+const write = async (name, asset) => {
+
+	const [ base, extension ] = name.split('.')
+	const file = `${ base }.${ asset.hash }.${ extension }`
+
+	await writeFile(resolve(distPath, file), asset.content)
+	await writeFile(resolve(distPath, `${ file }.gz`), asset.gzip)
+	if (asset.brotli != null) await writeFile(resolve(distPath, `${ file }.br`), asset.brotli)
+
+	return file
+
+}
+
+const build = async () => {
+
+	signale.await('Compiling assets')
+
+	const entries = {}
+
+	for (const name of Object.keys(assets.files)) {
+		const { type, compile } = assets.files[name]
+		entries[name] = createAsset({ content: await compile(true), type })
+	}
+
+	entries['index.html'] = createAsset({
+		content: assets.html(entries['index.css'], entries['index.js']),
+		type: assets.htmlType
+	})
+
+	await mkdir(distPath, { recursive: true })
+
+	const manifest = {
+		env: assets.env(true),
+		assets: {}
+	}
+
+	for (const name of Object.keys(entries)) {
+		manifest.assets[name] = {
+			file: await write(name, entries[name]),
+			type: entries[name].type
+		}
+	}
+
+	await writeFile(resolve(distPath, 'manifest.json'), JSON.stringify(manifest, null, '\t'))
+
+	signale.success(`Built ${ Object.keys(entries).length } assets in ${ distPath }`)
+
+}
+
+build().catch((err) => {
+
+	signale.fatal(err)
+	process.exit(1)
+
+})
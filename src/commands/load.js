@@ -0,0 +1,289 @@
+#!/usr/bin/env node
+'use strict'
+
+require('dotenv').config()
+
+const http = require('http')
+const https = require('https')
+const { writeFile } = require('fs').promises
+const fetch = require('node-fetch')
+
+const signale = require('../utils/signale')
+const sleep = require('../utils/sleep')
+const randomInt = require('../utils/randomInt')
+const randomItem = require('../utils/randomItem')
+const percentile = require('../utils/percentile')
+const parseArgs = require('../utils/parseArgs')
+const { createRecord, addToken } = require('../utils/fillDatabase')
+
+const args = parseArgs(process.argv.slice(2))
+
+const options = {
+	url: args.url || `http://localhost:${ process.env.ACKEE_PORT || process.env.PORT || 3000 }`,
+	rate: Number.parseFloat(args.rate) || 50,
+	duration: Number.parseFloat(args.duration) || 60,
+	concurrency: Number.parseInt(args.concurrency) || 100,
+	domains: Number.parseInt(args.domains) || 1,
+	heartbeats: args.heartbeats == null ? 2 : Number.parseFloat(args.heartbeats),
+	heartbeatDelay: args['heartbeat-delay'] == null ? 1000 : Number.parseInt(args['heartbeat-delay']),
+	dashboardRate: args['dashboard-rate'] == null ? 1 : Number.parseFloat(args['dashboard-rate']),
+	metricsToken: args['metrics-token'],
+	output: args.output
+}
+
+const agent = new (options.url.startsWith('https') ? https : http).Agent({
+	keepAlive: true,
+	maxSockets: options.concurrency
+})
+
+const operations = {
+	add: { latencies: [], errors: 0 },
+	update: { latencies: [], errors: 0 },
+	dashboard: { latencies: [], errors: 0 }
+}
+
+let inFlight = 0
+let skipped = 0
+
+// Measures a request and counts failed requests and responses with an error status
+const measure = async (name, url, opts) => {
+
+	const start = process.hrtime()
+	inFlight++
+
+	try {
+
+		const response = await fetch(url, { agent, ...opts })
+
+		// Error responses aren't always JSON and still have a latency
+		const [ seconds, nanoseconds ] = process.hrtime(start)
+		operations[name].latencies.push(seconds * 1e3 + nanoseconds / 1e6)
+
+		if (response.ok === false) {
+			operations[name].errors++
+			// Unread bodies would keep the socket of the agent busy
+			await response.text()
+			return
+		}
+
+		const data = await response.json()
+
+		return data.data
+
+	} catch (err) {
+
+		operations[name].errors++
+
+	} finally {
+
+		inFlight--
+
+	}
+
+}
+
+// Each visitor gets its own IP and user-agent so it receives a new clientId
+const visit = async (domain) => {
+
+	const headers = {
+		'Content-Type': 'application/json',
+		'User-Agent': `ackee-load/${ randomInt(0, 1e6) }`,
+		'X-Forwarded-For': `10.${ randomInt(0, 255) }.${ randomInt(0, 255) }.${ randomInt(0, 255) }`
+	}
+
+	const record = await measure('add', `${ options.url }/domains/${ domain.id }/records`, {
+		method: 'post',
+		headers,
+		body: JSON.stringify(createRecord())
+	})
+
+	if (record == null) return
+
+	// The fraction of the ratio adds another heartbeat to some of the visits
+	const heartbeats = Math.floor(options.heartbeats) + (Math.random() < options.heartbeats % 1 ? 1 : 0)
+
+	for (let i = 0; i < heartbeats; i++) {
+		await sleep(options.heartbeatDelay)
+		await measure('update', `${ options.url }/domains/${ domain.id }/records/${ record.id }`, {
+			method: 'patch',
+			headers
+		})
+	}
+
+}
+
+// Reads the CPU time of the instance from its metrics. Only includes the process that responds,
+// so instances with multiple workers can't be measured.
+const cpuSeconds = async () => {
+
+	if (options.metricsToken == null) return
+
+	const response = await fetch(`${ options.url }/metrics`, {
+		headers: { Authorization: `Bearer ${ options.metricsToken }` }
+	})
+
+	if (response.ok === false) throw new Error(`Failed to read metrics with status ${ response.status }`)
+
+	const match = /^ackee_process_cpu_seconds (\S+)$/m.exec(await response.text())
+
+	if (match == null) throw new Error('Metrics don\'t contain the CPU time')
+
+	return Number.parseFloat(match[1])
+
+}
+
+const loadDomains = async (token) => {
+
+	const headers = {
+		'Authorization': `Bearer ${ token }`,
+		'Content-Type': 'application/json'
+	}
+
+	const response = await fetch(`${ options.url }/domains`, { headers })
+	const { data } = await response.json()
+	const domains = data.map((entry) => entry.data)
+
+	// Create the missing domains of the test
+	for (let i = domains.length; i < options.domains; i++) {
+		const response = await fetch(`${ options.url }/domains`, {
+			method: 'post',
+			headers,
+			body: JSON.stringify({ title: `Load test ${ i + 1 }` })
+		})
+		const { data } = await response.json()
+		domains.push(data)
+	}
+
+	return domains.slice(0, options.domains)
+
+}
+
+// Starts requests with a fixed rate, independent of how fast the server responds.
+// Requests above the concurrency are skipped and show that the server is saturated.
+const run = (rate, fn) => {
+
+	if (rate <= 0) return Promise.resolve()
+
+	const end = Date.now() + options.duration * 1000
+	const pending = []
+
+	return new Promise((resolve) => {
+
+		const timer = setInterval(() => {
+
+			if (Date.now() >= end) {
+				clearInterval(timer)
+				return resolve(Promise.all(pending))
+			}
+
+			if (inFlight >= options.concurrency) return skipped++
+
+			pending.push(fn())
+
+		}, 1000 / rate)
+
+	})
+
+}
+
+const summary = (operation) => {
+
+	const latencies = [ ...operation.latencies ].sort((a, b) => a - b)
+	const requests = operation.latencies.length + operation.errors
+
+	return {
+		requests,
+		errors: operation.errors,
+		errorRate: requests === 0 ? 0 : operation.errors / requests,
+		throughput: latencies.length / options.duration,
+		p50: percentile(latencies, 50),
+		p95: percentile(latencies, 95),
+		p99: percentile(latencies, 99),
+		max: latencies.length === 0 ? null : latencies[latencies.length - 1]
+	}
+
+}
+
+// CPU time of the instance per request of all endpoints. Buffered writes run after the
+// requests and are only included when they've been flushed before the end of the test.
+const cpu = (seconds) => {
+
+	const requests = Object.values(operations).reduce((acc, operation) => acc + operation.latencies.length + operation.errors, 0)
+
+	return {
+		seconds,
+		perRequest: requests === 0 ? 0 : seconds * 1e3 / requests
+	}
+
+}
+
+const load = async () => {
+
+	signale.await(`Preparing load test against ${ options.url }`)
+
+	const token = await addToken(options.url)
+	const domains = await loadDomains(token)
+
+	// Each metric requires its own parameters like the cards of the UI
+	const dashboardQuery = [
+		'metrics=views,pages,referrers,durations',
+		'range=weekly',
+		'views.type=total',
+		'views.interval=daily',
+		'pages.sorting=top',
+		'referrers.sorting=top',
+		'durations.type=average',
+		`domainIds=${ domains.map((domain) => domain.id).join(',') }`
+	]
+
+	const dashboardUrl = `${ options.url }/dashboard?${ dashboardQuery.join('&') }`
+
+	const cpuStart = await cpuSeconds()
+
+	signale.start(`Sending ${ options.rate } visits/s to ${ domains.length } domains for ${ options.duration } s`)
+
+	await Promise.all([
+		run(options.rate, () => visit(randomItem(domains))),
+		run(options.dashboardRate, () => measure('dashboard', dashboardUrl, {
+			headers: { Authorization: `Bearer ${ token }` }
+		}))
+	])
+
+	const cpuEnd = await cpuSeconds()
+
+	const result = {
+		options,
+		skipped,
+		cpu: cpuStart == null ? undefined : cpu(cpuEnd - cpuStart),
+		operations: {
+			'POST /domains/:domainId/records': summary(operations.add),
+			'PATCH /domains/:domainId/records/:recordId': summary(operations.update),
+			'GET /dashboard': summary(operations.dashboard)
+		}
+	}
+
+	Object.keys(result.operations).forEach((name) => {
+		const { requests, errorRate, p50, p95, p99 } = result.operations[name]
+		const format = (value) => value == null ? '-' : `${ value.toFixed(1) } ms`
+		signale.info(`${ name }: ${ requests } requests, ${ (errorRate * 100).toFixed(2) } % errors, p50 ${ format(p50) }, p95 ${ format(p95) }, p99 ${ format(p99) }`)
+	})
+
+	if (result.cpu != null) signale.info(`CPU: ${ result.cpu.seconds.toFixed(1) } s, ${ result.cpu.perRequest.toFixed(3) } ms per request`)
+
+	if (skipped > 0) signale.warn(`Skipped ${ skipped } requests because ${ options.concurrency } requests were pending`)
+
+	if (options.output != null) {
+		await writeFile(options.output, JSON.stringify(result, null, '\t'))
+		signale.success(`Saved results to ${ options.output }`)
+	}
+
+	agent.destroy()
+
+}
+
+load().catch((err) => {
+
+	signale.fatal(err)
+	process.exit(1)
+
+})
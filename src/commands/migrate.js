@@ -0,0 +1,96 @@
+#!/usr/bin/env node
+'use strict'
+
+require('dotenv').config()
+
+const mongoose = require('mongoose')
+
+const Record = require('../schemas/Record')
+const records = require('../database/records')
+const signale = require('../utils/signale')
+const connect = require('../utils/connect')
+const stripUrlAuth = require('../utils/stripUrlAuth')
+const parseArgs = require('../utils/parseArgs')
+const timeSeries = require('../utils/timeSeries')
+const dayKeyExpression = require('../utils/dayKeyExpression')
+
+const args = parseArgs(process.argv.slice(2))
+const dbUrl = process.env.ACKEE_MONGODB || process.env.MONGODB_URI
+
+if (dbUrl == null) {
+	signale.fatal('MongoDB connection URI missing in environment')
+	process.exit(1)
+}
+
+if (timeSeries.enabled === false) {
+	signale.fatal('Time-series collections are disabled. Set `ACKEE_TIME_SERIES=true` to migrate the records')
+	process.exit(1)
+}
+
+// Records of older versions might not have a day yet
+const migration = (name) => [
+	{
+		$set: {
+			day: dayKeyExpression()
+		}
+	},
+	{
+		$out: {
+			db: mongoose.connection.db.databaseName,
+			coll: name,
+			timeseries: timeSeries.options('created')
+		}
+	}
+]
+
+signale.await(`Connecting to ${ stripUrlAuth(dbUrl) }`)
+
+connect(dbUrl).then(async () => {
+
+	signale.success(`Connected to ${ stripUrlAuth(dbUrl) }`)
+
+	const name = Record.collection.collectionName
+	const type = await timeSeries.collectionType(Record)
+
+	if (type === 'timeseries') {
+		signale.success('Records are already stored in a time-series collection')
+		return mongoose.disconnect()
+	}
+
+	// Time-series collections can't be renamed, so the existing collection is moved aside
+	// and the records are copied into a new collection with the original name
+	const backupName = `${ name }_backup_${ Date.now() }`
+
+	if (type != null) {
+		signale.await(`Moving records to \`${ backupName }\``)
+		await mongoose.connection.db.renameCollection(name, backupName)
+	}
+
+	signale.await('Creating time-series collections')
+	await records.prepare()
+
+	if (type != null) {
+
+		signale.await('Copying records')
+		await mongoose.connection.db.collection(backupName).aggregate(migration(name), { allowDiskUse: true }).toArray()
+
+		const count = await Record.estimatedDocumentCount()
+		signale.success(`Copied ${ count } records`)
+
+		if (args.drop === true) {
+			await mongoose.connection.db.dropCollection(backupName)
+			signale.success(`Removed \`${ backupName }\``)
+		} else {
+			signale.info(`Remove \`${ backupName }\` once the records have been verified or run with \`--drop\``)
+		}
+
+	}
+
+	await mongoose.disconnect()
+
+}).catch((err) => {
+
+	signale.fatal(err)
+	process.exit(1)
+
+})
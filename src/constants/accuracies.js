@@ -0,0 +1,15 @@
+// Constants will be shared between client and server.
+// They will be used as values in the URL of the metric calls.
+const ACCURACIES_EXACT = 'exact'
+const ACCURACIES_APPROXIMATE = 'approx'
+
+const toArray = () => [
+	ACCURACIES_EXACT,
+	ACCURACIES_APPROXIMATE
+]
+
+module.exports = {
+	ACCURACIES_EXACT,
+	ACCURACIES_APPROXIMATE,
+	toArray
+}
@@ -0,0 +1,36 @@
+// Constants will be shared between client and server.
+// They will be used as values in the URL of the dashboard calls.
+const METRICS_VIEWS = 'views'
+const METRICS_PAGES = 'pages'
+const METRICS_REFERRERS = 'referrers'
+const METRICS_DURATIONS = 'durations'
+const METRICS_LANGUAGES = 'languages'
+const METRICS_SIZES = 'sizes'
+const METRICS_SYSTEMS = 'systems'
+const METRICS_DEVICES = 'devices'
+const METRICS_BROWSERS = 'browsers'
+
+const toArray = () => [
+	METRICS_VIEWS,
+	METRICS_PAGES,
+	METRICS_REFERRERS,
+	METRICS_DURATIONS,
+	METRICS_LANGUAGES,
+	METRICS_SIZES,
+	METRICS_SYSTEMS,
+	METRICS_DEVICES,
+	METRICS_BROWSERS
+]
+
+module.exports = {
+	METRICS_VIEWS,
+	METRICS_PAGES,
+	METRICS_REFERRERS,
+	METRICS_DURATIONS,
+	METRICS_LANGUAGES,
+	METRICS_SIZES,
+	METRICS_SYSTEMS,
+	METRICS_DEVICES,
+	METRICS_BROWSERS,
+	toArray
+}
@@ -1,46 +1,56 @@
 'use strict'
 
 const Record = require('../schemas/Record')
+const sketches = require('./sketches')
+const dictionary = require('./dictionary')
 const aggregateRecentFieldsMultiple = require('../aggregations/aggregateRecentFieldsMultiple')
 const aggregateTopFieldsMultiple = require('../aggregations/aggregateTopFieldsMultiple')
 const aggregateTopFields = require('../aggregations/aggregateTopFields')
 const aggregateRecentFields = require('../aggregations/aggregateRecentFields')
 const constants = require('../constants/browsers')
+const metrics = require('../constants/metrics')
+const cacheResult = require('../utils/cacheResult')
+const sampling = require('../utils/sampling')
+const analytics = require('../utils/analytics')
 
-const getTopWithVersion = async (id, range) => {
+const getTopWithVersion = cacheResult(metrics.METRICS_BROWSERS, 'topWithVersion', async (id, range, accuracy) => {
 
-	return Record.aggregate(
-		aggregateTopFieldsMultiple(id, [ 'browserName', 'browserVersion' ], range)
-	)
-}
+	if (sketches.enabled === true) return sketches.getTop(id, [ 'browserName', 'browserVersion' ], range)
+
+	return dictionary.decode([ 'browserName', 'browserVersion' ], await analytics.model(Record).aggregate(
+		aggregateTopFieldsMultiple(id, [ 'browserName', 'browserVersion' ], range, sampling(accuracy))
+	))
+})
 
 const getRecentWithVersion = async (id) => {
 
-	return Record.aggregate(
+	return dictionary.decode([ 'browserName', 'browserVersion' ], await analytics.model(Record).aggregate(
 		aggregateRecentFieldsMultiple(id, [ 'browserName', 'browserVersion' ])
-	)
+	))
 }
 
-const getTopNoVersion = async (id, range) => {
+const getTopNoVersion = cacheResult(metrics.METRICS_BROWSERS, 'topNoVersion', async (id, range, accuracy) => {
 
-	return Record.aggregate(
-		aggregateTopFields(id, 'browserName', range)
-	)
-}
+	if (sketches.enabled === true) return sketches.getTop(id, [ 'browserName' ], range)
+
+	return dictionary.decode([ 'browserName' ], await analytics.model(Record).aggregate(
+		aggregateTopFields(id, 'browserName', range, sampling(accuracy))
+	))
+})
 
 const getRecentNoVersion = async (id) => {
 
-	return Record.aggregate(
+	return dictionary.decode([ 'browserName' ], await analytics.model(Record).aggregate(
 		aggregateRecentFields(id, 'browserName')
-	)
+	))
 }
 
 
-const get = async (id, sorting, type, range) => {
+const get = async (id, sorting, type, range, accuracy) => {
 
 	switch (sorting) {
 		case constants.BROWSERS_SORTING_TOP:
-			return type === constants.BROWSERS_TYPE_NO_VERSION ? getTopNoVersion(id, range) : getTopWithVersion(id, range)
+			return type === constants.BROWSERS_TYPE_NO_VERSION ? getTopNoVersion(id, range, accuracy) : getTopWithVersion(id, range, accuracy)
 		case constants.BROWSERS_SORTING_RECENT:
 			return type === constants.BROWSERS_TYPE_NO_VERSION ? getRecentNoVersion(id) : getRecentWithVersion(id)
 	}
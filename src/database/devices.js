@@ -1,46 +1,56 @@
 'use strict'
 
 const Record = require('../schemas/Record')
+const sketches = require('./sketches')
+const dictionary = require('./dictionary')
 const aggregateRecentFieldsMultiple = require('../aggregations/aggregateRecentFieldsMultiple')
 const aggregateTopFieldsMultiple = require('../aggregations/aggregateTopFieldsMultiple')
 const aggregateTopFields = require('../aggregations/aggregateTopFields')
 const aggregateRecentFields = require('../aggregations/aggregateRecentFields')
 const constants = require('../constants/devices')
+const metrics = require('../constants/metrics')
+const cacheResult = require('../utils/cacheResult')
+const sampling = require('../utils/sampling')
+const analytics = require('../utils/analytics')
 
-const getTopWithModel = async (id, range) => {
+const getTopWithModel = cacheResult(metrics.METRICS_DEVICES, 'topWithModel', async (id, range, accuracy) => {
 
-	return Record.aggregate(
-		aggregateTopFieldsMultiple(id, [ 'deviceManufacturer', 'deviceName' ], range)
-	)
-}
+	if (sketches.enabled === true) return sketches.getTop(id, [ 'deviceManufacturer', 'deviceName' ], range)
+
+	return dictionary.decode([ 'deviceManufacturer', 'deviceName' ], await analytics.model(Record).aggregate(
+		aggregateTopFieldsMultiple(id, [ 'deviceManufacturer', 'deviceName' ], range, sampling(accuracy))
+	))
+})
 
 const getRecentWithModel = async (id) => {
 
-	return Record.aggregate(
+	return dictionary.decode([ 'deviceManufacturer', 'deviceName' ], await analytics.model(Record).aggregate(
 		aggregateRecentFieldsMultiple(id, [ 'deviceManufacturer', 'deviceName' ])
-	)
+	))
 }
 
-const getTopNoModel = async (id, range) => {
+const getTopNoModel = cacheResult(metrics.METRICS_DEVICES, 'topNoModel', async (id, range, accuracy) => {
 
-	return Record.aggregate(
-		aggregateTopFields(id, 'deviceManufacturer', range)
-	)
-}
+	if (sketches.enabled === true) return sketches.getTop(id, [ 'deviceManufacturer' ], range)
+
+	return dictionary.decode([ 'deviceManufacturer' ], await analytics.model(Record).aggregate(
+		aggregateTopFields(id, 'deviceManufacturer', range, sampling(accuracy))
+	))
+})
 
 const getRecentNoModel = async (id) => {
 
-	return Record.aggregate(
+	return dictionary.decode([ 'deviceManufacturer' ], await analytics.model(Record).aggregate(
 		aggregateRecentFields(id, 'deviceManufacturer')
-	)
+	))
 }
 
 
-const get = async (id, sorting, type, range) => {
+const get = async (id, sorting, type, range, accuracy) => {
 
 	switch (sorting) {
 		case constants.DEVICES_SORTING_TOP:
-			return type === constants.DEVICES_TYPE_NO_MODEL ? getTopNoModel(id, range) : getTopWithModel(id, range)
+			return type === constants.DEVICES_TYPE_NO_MODEL ? getTopNoModel(id, range, accuracy) : getTopWithModel(id, range, accuracy)
 		case constants.DEVICES_SORTING_RECENT:
 			return type === constants.DEVICES_TYPE_NO_MODEL ? getRecentNoModel(id) : getRecentWithModel(id)
 	}
@@ -0,0 +1,157 @@
+'use strict'
+
+const Dimension = require('../schemas/Dimension')
+const createCache = require('../utils/createCache')
+
+// Opt-in storage mode that stores the ids of values on records instead of the values themselves.
+// Aggregations group the ids, which are decoded afterwards.
+const enabled = process.env.ACKEE_DICTIONARY === 'true'
+
+// Strings with few distinct values that are repeated by most records
+const properties = [
+	'siteLocation',
+	'siteReferrer',
+	'siteLanguage',
+	'deviceName',
+	'deviceManufacturer',
+	'osName',
+	'osVersion',
+	'browserName',
+	'browserVersion'
+]
+
+// Values never change their id, so cached entries don't expire
+const ids = createCache({ max: 10000 })
+const values = createCache({ max: 10000 })
+const pending = new Map()
+
+const remember = (entry) => {
+
+	ids.set(`${ entry.property }:${ entry.value }`, entry.id)
+	values.set(`${ entry.property }:${ entry.id }`, entry.value)
+
+}
+
+// Returns the id of a value and adds it when it's new. Ids are unique per property, so
+// a value or id that has been added by another process in the meantime causes a retry.
+const intern = async (property, value) => {
+
+	const existingEntry = await Dimension.findOne({ property, value }, { id: 1 }).lean()
+
+	if (existingEntry != null) return existingEntry.id
+
+	const lastEntry = await Dimension.findOne({ property }, { id: 1 }).sort({ id: -1 }).lean()
+	const id = lastEntry == null ? 1 : lastEntry.id + 1
+
+	try {
+		await Dimension.create({ property, value, id })
+		return id
+	} catch (err) {
+		if (err.code !== 11000) throw err
+		return intern(property, value)
+	}
+
+}
+
+const getId = (property, value) => {
+
+	const key = `${ property }:${ value }`
+	const cachedId = ids.get(key)
+
+	if (cachedId !== undefined) return Promise.resolve(cachedId)
+
+	// Concurrent records with the same new value share the lookup
+	if (pending.has(key) === false) {
+		pending.set(key, intern(property, value).then((id) => {
+			remember({ property, value, id })
+			return id
+		}).finally(() => pending.delete(key)))
+	}
+
+	return pending.get(key)
+
+}
+
+const isEncoded = (property, value) => typeof value === 'number' && properties.includes(property)
+const isDecoded = (property, value) => typeof value === 'string' && properties.includes(property)
+
+// Returns a copy of a record with ids instead of the values of the properties
+const encode = async (record) => {
+
+	const encodedRecord = { ...record }
+
+	await Promise.all(properties.map(async (property) => {
+		if (isDecoded(property, record[property]) === false) return
+		encodedRecord[property] = await getId(property, record[property])
+	}))
+
+	return encodedRecord
+
+}
+
+// Returns copies of objects with the values of encoded properties. Ids that aren't cached
+// are loaded with one query. Strings of records that have been added before are kept.
+const decodeObjects = async (objects) => {
+
+	const resolved = new Map()
+	const missing = []
+
+	objects.forEach((object) => Object.keys(object).forEach((property) => {
+
+		if (isEncoded(property, object[property]) === false) return
+
+		const key = `${ property }:${ object[property] }`
+		const value = values.get(key)
+
+		if (value === undefined) missing.push({ property, id: object[property] })
+		else resolved.set(key, value)
+
+	}))
+
+	if (missing.length > 0) {
+		const entries = await Dimension.find({ $or: missing }).lean()
+		entries.forEach((entry) => {
+			remember(entry)
+			resolved.set(`${ entry.property }:${ entry.id }`, entry.value)
+		})
+	}
+
+	return objects.map((object) => Object.keys(object).reduce((acc, property) => {
+		const key = `${ property }:${ object[property] }`
+		acc[property] = resolved.has(key) === true ? resolved.get(key) : object[property]
+		return acc
+	}, {}))
+
+}
+
+const decodeRecord = async (record) => {
+
+	const [ decodedRecord ] = await decodeObjects([ record ])
+
+	return decodedRecord
+
+}
+
+// Decodes the grouped values of aggregation results. The value is either the value of a single
+// property or an object with the values of multiple properties.
+const decode = async (groupedProperties, entries, key = '_id') => {
+
+	const isSingle = groupedProperties.length === 1
+	const property = groupedProperties[0]
+
+	const decodedValues = await decodeObjects(entries.map((entry) => isSingle === true ? { [property]: entry[key] } : entry[key]))
+
+	return entries.map((entry, index) => ({
+		...entry,
+		[key]: isSingle === true ? decodedValues[index][property] : decodedValues[index]
+	}))
+
+}
+
+module.exports = {
+	enabled,
+	properties,
+	encode,
+	decode,
+	decodeRecord
+}
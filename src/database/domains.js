@@ -2,10 +2,25 @@
 
 const Domain = require('../schemas/Domain')
 const runUpdate = require('../utils/runUpdate')
+const createCache = require('../utils/createCache')
+const { minute } = require('../utils/times')
+
+const cacheTtl = process.env.ACKEE_DOMAIN_CACHE_TTL == null ? minute : Number.parseInt(process.env.ACKEE_DOMAIN_CACHE_TTL)
+
+// Domains rarely change, but are requested for every new record. Changes made by
+// other processes will be visible once the cached entry expired.
+const cache = createCache({
+	max: 1000,
+	ttl: cacheTtl
+})
 
 const add = async (data) => {
 
-	return Domain.create(data)
+	const entry = await Domain.create(data)
+
+	cache.del(entry.id)
+
+	return entry
 
 }
 
@@ -30,26 +45,42 @@ const all = async () => {
 
 const get = async (id) => {
 
-	return Domain.findOne({
+	const cachedEntry = cache.get(id)
+
+	if (cachedEntry != null) return cachedEntry
+
+	const entry = await Domain.findOne({
 		id
 	})
 
+	if (entry != null) cache.set(id, entry)
+
+	return entry
+
 }
 
 const update = async (id, data) => {
 
-	return runUpdate(Domain, id, data, [
+	const entry = await runUpdate(Domain, id, data, [
 		'title'
 	])
 
+	cache.del(id)
+
+	return entry
+
 }
 
 const del = async (id) => {
 
-	return Domain.findOneAndDelete({
+	const entry = await Domain.findOneAndDelete({
 		id
 	})
 
+	cache.del(id)
+
+	return entry
+
 }
 
 module.exports = {
@@ -1,196 +1,150 @@
 'use strict'
 
-const { subDays } = require('date-fns')
-
 const Record = require('../schemas/Record')
+const Duration = require('../schemas/Duration')
+const Heartbeat = require('../schemas/Heartbeat')
+const aggregateDurationRollups = require('../aggregations/aggregateDurationRollups')
+const aggregateAverageDurations = require('../aggregations/aggregateAverageDurations')
+const aggregateDetailedDurations = require('../aggregations/aggregateDetailedDurations')
+const aggregateRecordHeartbeats = require('../aggregations/aggregateRecordHeartbeats')
 const constants = require('../constants/durations')
-const zeroDate = require('../utils/zeroDate')
-
-// The time that elapsed between the creation and updating of records.
-const projectDuration = {
-	$project: {
-		created: '$created',
-		duration: {
-			$subtract: [ '$updated', '$created' ]
-		}
-	}
-}
+const dayKey = require('../utils/dayKey')
+const dayIndex = require('../utils/dayIndex')
+const analytics = require('../utils/analytics')
+const versions = require('../utils/versions')
+const timeSeries = require('../utils/timeSeries')
 
-// Ackee tracks durations in an interval, but some durations are between
-// possible interval times. This could be caused by a network delay or the
-// browser who's throttling JS execution. This step rounds all durations
-// down to the nearest possible interval to get rid of inaccuracy.
-const projectInterval = {
-	$project: {
-		created: '$created',
-		duration: {
-			$multiply: [
-				{
-					$floor: [
-						{
-							$divide: [ '$duration', constants.DURATIONS_INTERVAL ]
-						}
-					]
-				},
-				constants.DURATIONS_INTERVAL
-			]
-		}
-	}
-}
+// Durations change with every update of a record. Their version is separate from the
+// version of the domain, which would otherwise invalidate all cached results of it.
+const version = (id) => `${ id }:durations`
 
-// Visits below the tracking interval will have a duration of zero. That's
-// incorrect as visitors spent time on the site, but just not enough. This
-// step sets the minimum duration to the half of the tracking interval.
-// This value is a compromise that doesn't influence the average too much.
-const projectMinInterval = {
-	$project: {
-		created: '$created',
-		duration: {
-			$cond: {
-				if: {
-					$lt: [ '$duration', constants.DURATIONS_INTERVAL ]
-				},
-				then: constants.DURATIONS_INTERVAL / 2,
-				else: '$duration'
-			}
-		}
-	}
-}
+// Moves records between the buckets of the daily histograms. Changes without
+// a `from` bucket are new records. All changes are written with one bulk write.
+const track = async (changes) => {
+
+	const increments = new Map()
+
+	changes.forEach((change) => {
+
+		if (change.from === change.to) return
 
-// Some visitors keep sites open in the background. Their duration is often
-// way above the limit. This distorts the average and should be omitted.
-const matchLimit = {
-	$match: {
-		duration: {
-			$lt: constants.DURATIONS_LIMIT
+		const day = dayKey(change.created)
+		const key = `${ change.domainId }:${ day }`
+		const increment = increments.get(key) || { domainId: change.domainId, day, $inc: {} }
+
+		increment.$inc[`buckets.${ change.to }`] = (increment.$inc[`buckets.${ change.to }`] || 0) + 1
+		if (change.from != null) increment.$inc[`buckets.${ change.from }`] = (increment.$inc[`buckets.${ change.from }`] || 0) - 1
+
+		increments.set(key, increment)
+
+	})
+
+	// No need to continue when nothing changed
+	if (increments.size === 0) return
+
+	await Duration.bulkWrite([ ...increments.values() ].map((increment) => ({
+		updateOne: {
+			filter: {
+				domainId: increment.domainId,
+				day: increment.day
+			},
+			update: {
+				$inc: increment.$inc
+			},
+			upsert: true
 		}
-	}
+	})), {
+		ordered: false
+	})
+
+	const domainIds = new Set([ ...increments.values() ].map((increment) => increment.domainId))
+
+	return Promise.all([ ...domainIds ].map((domainId) => versions.bump(version(domainId))))
+
 }
 
-const getAverage = async (id) => {
+// Builds the histograms of all matching records. Existing histograms are either replaced
+// or kept when they already include the records.
+const rollup = async (filter, replace) => {
 
-	return Record.aggregate([
-		{
-			$match: {
-				domainId: id
-			}
-		},
-		projectDuration,
-		projectInterval,
-		projectMinInterval,
-		matchLimit,
-		{
-			$group: {
-				_id: {
-					day: {
-						$dayOfMonth: '$created'
-					},
-					month: {
-						$month: '$created'
-					},
-					year: {
-						$year: '$created'
-					}
-				},
-				average: {
-					$avg: '$duration'
-				}
-			}
-		},
+	const entries = await Record.aggregate([
 		{
-			$sort: {
-				'_id.year': -1,
-				'_id.month': -1,
-				'_id.day': -1
-			}
+			$match: filter
 		},
-		{
-			$limit: 14
+		// Durations of records in time-series collections end with their latest heartbeat
+		...(timeSeries.enabled === true ? aggregateRecordHeartbeats(Heartbeat.collection.collectionName) : []),
+		...aggregateDurationRollups()
+	]).allowDiskUse(true)
+
+	// No need to continue when there're no entries
+	if (entries.length === 0) return 0
+
+	await Duration.bulkWrite(entries.map(({ domainId, day, ...data }) => (replace === true ? {
+		replaceOne: {
+			filter: { domainId, day },
+			replacement: { domainId, day, ...data },
+			upsert: true
 		}
-	])
+	} : {
+		updateOne: {
+			filter: { domainId, day },
+			update: { $setOnInsert: data },
+			upsert: true
+		}
+	})), {
+		ordered: false
+	})
+
+	return entries.length
 
 }
 
-const getDetailed = async (id) => {
+const backfill = () => rollup({}, true)
 
-	const averageEntries = await Record.aggregate([
-		{
-			$match: {
-				domainId: id,
-				created: {
-					$gte: subDays(zeroDate(), 6)
-				}
-			}
-		},
-		projectDuration,
-		projectInterval,
-		projectMinInterval,
-		matchLimit,
-		{
-			$group: {
-				_id: null,
-				average: {
-					$avg: '$duration'
-				}
-			}
-		}
-	])
+// Makes sure that the histograms include the matching records before they're removed
+const fold = (filter) => rollup(filter, false)
+
+const getAverage = async (id, range) => {
+
+	return analytics.model(Duration).aggregate(
+		aggregateAverageDurations(id, range)
+	)
+
+}
+
+// Uses the last 7 days without a custom range
+const getDetailed = async (id, range) => {
+
+	const [ result ] = await analytics.model(Duration).aggregate(range == null ?
+		aggregateDetailedDurations(id, dayIndex.toDayKey(dayIndex(dayKey()) - 6)) :
+		aggregateDetailedDurations(id, range.from, range.to)
+	)
 
 	// No need to continue when there're no entries
-	if (averageEntries.length === 0) return []
+	if (result.average.length === 0 || result.average[0].count === 0) return []
 
-	const detailedEntries = await Record.aggregate([
-		{
-			$match: {
-				domainId: id,
-				created: {
-					$gte: subDays(zeroDate(), 6)
-				}
-			}
-		},
-		projectDuration,
-		projectInterval,
-		{
-			$group: {
-				_id: {
-					$cond: {
-						if: {
-							$gte: [ '$duration', constants.DURATIONS_LIMIT ]
-						},
-						then: constants.DURATIONS_LIMIT,
-						else: '$duration'
-					}
-				},
-				count: {
-					$sum: 1
-				}
-			}
-		},
-		{
-			$addFields: {
-				average: averageEntries[0].average
-			}
-		},
-		{
-			$sort: {
-				_id: 1
-			}
-		}
-	])
+	const average = result.average[0].duration / result.average[0].count
 
-	return detailedEntries
+	return result.detailed.map((entry) => ({
+		...entry,
+		average
+	}))
 
 }
 
-const get = async (id, type) => {
+const get = async (id, type, range) => {
 
 	switch (type) {
-		case constants.DURATIONS_TYPE_AVERAGE: return getAverage(id)
-		case constants.DURATIONS_TYPE_DETAILED: return getDetailed(id)
+		case constants.DURATIONS_TYPE_AVERAGE: return getAverage(id, range)
+		case constants.DURATIONS_TYPE_DETAILED: return getDetailed(id, range)
 	}
 
 }
 
 module.exports = {
-	get
-}
\ No newline at end of file
+	version,
+	track,
+	get,
+	backfill,
+	fold
+}
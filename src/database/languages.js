@@ -1,30 +1,38 @@
 'use strict'
 
 const Record = require('../schemas/Record')
+const sketches = require('./sketches')
+const dictionary = require('./dictionary')
 const aggregateTopFields = require('../aggregations/aggregateTopFields')
 const aggregateRecentFields = require('../aggregations/aggregateRecentFields')
 const constants = require('../constants/languages')
+const metrics = require('../constants/metrics')
+const cacheResult = require('../utils/cacheResult')
+const sampling = require('../utils/sampling')
+const analytics = require('../utils/analytics')
 
-const getTop = async (id, range) => {
+const getTop = cacheResult(metrics.METRICS_LANGUAGES, 'top', async (id, range, accuracy) => {
 
-	return Record.aggregate(
-		aggregateTopFields(id, 'siteLanguage', range)
-	)
+	if (sketches.enabled === true) return sketches.getTop(id, [ 'siteLanguage' ], range)
 
-}
+	return dictionary.decode([ 'siteLanguage' ], await analytics.model(Record).aggregate(
+		aggregateTopFields(id, 'siteLanguage', range, sampling(accuracy))
+	))
+
+})
 
 const getRecent = async (id) => {
 
-	return Record.aggregate(
+	return dictionary.decode([ 'siteLanguage' ], await analytics.model(Record).aggregate(
 		aggregateRecentFields(id, 'siteLanguage')
-	)
+	))
 
 }
 
-const get = async (id, sorting, range) => {
+const get = async (id, sorting, range, accuracy) => {
 
 	switch (sorting) {
-		case constants.LANGUAGES_SORTING_TOP: return getTop(id, range)
+		case constants.LANGUAGES_SORTING_TOP: return getTop(id, range, accuracy)
 		case constants.LANGUAGES_SORTING_RECENT: return getRecent(id)
 	}
 
@@ -1,30 +1,38 @@
 'use strict'
 
 const Record = require('../schemas/Record')
+const sketches = require('./sketches')
+const dictionary = require('./dictionary')
 const aggregateTopFields = require('../aggregations/aggregateTopFields')
 const aggregateRecentFields = require('../aggregations/aggregateRecentFields')
 const constants = require('../constants/pages')
+const metrics = require('../constants/metrics')
+const cacheResult = require('../utils/cacheResult')
+const sampling = require('../utils/sampling')
+const analytics = require('../utils/analytics')
 
-const getTop = async (id, range) => {
+const getTop = cacheResult(metrics.METRICS_PAGES, 'top', async (id, range, accuracy) => {
 
-	return Record.aggregate(
-		aggregateTopFields(id, 'siteLocation', range)
-	)
+	if (sketches.enabled === true) return sketches.getTop(id, [ 'siteLocation' ], range)
 
-}
+	return dictionary.decode([ 'siteLocation' ], await analytics.model(Record).aggregate(
+		aggregateTopFields(id, 'siteLocation', range, sampling(accuracy))
+	))
+
+})
 
 const getRecent = async (id) => {
 
-	return Record.aggregate(
+	return dictionary.decode([ 'siteLocation' ], await analytics.model(Record).aggregate(
 		aggregateRecentFields(id, 'siteLocation')
-	)
+	))
 
 }
 
-const get = async (id, sorting, range) => {
+const get = async (id, sorting, range, accuracy) => {
 
 	switch (sorting) {
-		case constants.PAGES_SORTING_TOP: return getTop(id, range)
+		case constants.PAGES_SORTING_TOP: return getTop(id, range, accuracy)
 		case constants.PAGES_SORTING_RECENT: return getRecent(id)
 	}
 
@@ -1,51 +1,726 @@
 'use strict'
 
+const mongoose = require('mongoose')
+
 const Record = require('../schemas/Record')
-const runUpdate = require('../utils/runUpdate')
+const Heartbeat = require('../schemas/Heartbeat')
+const durations = require('./durations')
+const sketches = require('./sketches')
+const dictionary = require('./dictionary')
+const aggregateLatestHeartbeats = require('../aggregations/aggregateLatestHeartbeats')
+const aggregateRecordHeartbeats = require('../aggregations/aggregateRecordHeartbeats')
+const aggregateDuplicateClients = require('../aggregations/aggregateDuplicateClients')
+const signale = require('../utils/signale')
+const createBuffer = require('../utils/createBuffer')
+const mapLimit = require('../utils/mapLimit')
+const durationBucket = require('../utils/durationBucket')
+const dayKey = require('../utils/dayKey')
+const timeSeries = require('../utils/timeSeries')
+const versions = require('../utils/versions')
+const compileValidator = require('../utils/compileValidator')
+
+const ingestBufferSize = Number.parseInt(process.env.ACKEE_INGEST_BUFFER_SIZE)
+const ingestBufferInterval = Number.parseInt(process.env.ACKEE_INGEST_BUFFER_INTERVAL) || 1000
+const heartbeatInterval = Number.parseInt(process.env.ACKEE_HEARTBEAT_INTERVAL)
+const anonymizeInterval = Number.parseInt(process.env.ACKEE_ANONYMIZE_INTERVAL) || 1000
+
+// Records are validated as plain objects with the rules of the schema. Creating mongoose
+// documents is the most expensive part of adding a record.
+const validateRecord = compileValidator(Record.schema, mongoose.Error.messages)
+
+// Days are derived from the creation and never taken from the input
+const validate = (data) => validateRecord({ ...data, day: undefined })
+
+// Cached results and ETags of the domains are outdated once their records have been written
+const bumpVersions = (entries) => Promise.all([ ...new Set(entries.map((entry) => entry.domainId)) ].map(versions.bump))
+
+// Validated records are inserted with the driver. Mongoose would cast them again and
+// turn the ids of encoded dimensions back into strings.
+const encode = (entries) => dictionary.enabled === true ? Promise.all(entries.map(dictionary.encode)) : entries
+
+// Inserts the records of the ingest buffer. Failed batches are retried by the buffer, so records
+// of a previous attempt might already exist. Errors of single records won't change with a retry.
+const insert = async (entries) => {
 
-const add = async (data) => {
+	try {
 
-	return Record.create(data)
+		await Record.collection.insertMany(await encode(entries), { ordered: false })
+
+	} catch (err) {
+
+		const writeErrors = err.writeErrors || (err.result != null && typeof err.result.getWriteErrors === 'function' ? err.result.getWriteErrors() : undefined)
+
+		if (writeErrors == null || writeErrors.length === 0) throw err
+
+		writeErrors
+			.filter((writeError) => writeError.code !== 11000)
+			.forEach((writeError) => signale.fatal(`Failed to insert record: ${ writeError.errmsg }`))
+
+	}
+
+	return bumpVersions(entries)
 
 }
 
-const update = async (id) => {
+const create = async (data) => {
 
-	return runUpdate(Record, id)
+	const entry = validate(data)
+	const [ document ] = await encode([ entry ])
+
+	await Record.collection.insertOne(document)
+	await bumpVersions([ entry ])
+
+	return entry
+
+}
+
+// Returns the durations of records. Updates of records in time-series collections are stored as heartbeats.
+const findDurations = async (ids) => {
+
+	const entries = await Record.find({
+		id: {
+			$in: ids
+		}
+	}, {
+		id: 1,
+		domainId: 1,
+		created: 1,
+		updated: 1
+	}).lean()
+
+	if (timeSeries.enabled === false || entries.length === 0) return entries
+
+	const heartbeats = await Heartbeat.aggregate(aggregateLatestHeartbeats(entries.map((entry) => entry.id)))
+	const updates = new Map(heartbeats.map((heartbeat) => [ heartbeat._id, heartbeat.updated ]))
+
+	return entries.map((entry) => updates.has(entry.id) === false ? entry : {
+		...entry,
+		updated: new Date(Math.max(entry.updated, updates.get(entry.id)))
+	})
 
 }
 
-const anonymize = async (clientId, ignoreId) => {
+// Extends the durations of existing records. Time-series collections get a heartbeat per update.
+const writeUpdates = async (entries) => {
+
+	if (entries.length === 0) return
+
+	if (timeSeries.enabled === true) return Heartbeat.collection.insertMany(entries.map((entry) => ({
+		recordId: entry.id,
+		domainId: entry.domainId,
+		created: entry.created,
+		updated: entry.updated
+	})), {
+		ordered: false
+	})
 
-	return Record.updateMany({
-		$and: [
-			{ clientId },
-			{
-				id: {
-					$ne: ignoreId
+	return Record.bulkWrite(entries.map((entry) => ({
+		updateOne: {
+			filter: {
+				id: entry.id
+			},
+			update: {
+				$max: {
+					updated: entry.updated
 				}
 			}
-		]
+		}
+	})), {
+		ordered: false
+	})
+
+}
+
+// Opt-in buffer that collects validated records and inserts them in batches
+const ingestBuffer = ingestBufferSize > 1 ? createBuffer({
+	size: ingestBufferSize,
+	interval: ingestBufferInterval,
+	flush: async (entries) => {
+
+		await insert(entries)
+
+		// Heartbeats of buffered entries are already included in their duration.
+		// Only the insert is retried, so the records aren't counted twice.
+		durations.track(entries.map((entry) => ({
+			domainId: entry.domainId,
+			created: entry.created,
+			to: durationBucket(entry.created, entry.updated)
+		}))).catch((err) => signale.fatal(err))
+
+	}
+}) : undefined
+
+// Opt-in buffer that keeps the latest `updated` of each record and writes all of them at once
+const heartbeatBuffer = heartbeatInterval > 0 ? createBuffer({
+	interval: heartbeatInterval,
+	flush: async (entries) => {
+
+		// Records of a running ingest flush must exist before they can be updated
+		if (ingestBuffer != null) await ingestBuffer.flush()
+
+		// Records that failed to be inserted are buffered again and keep the update until they're written
+		const writtenEntries = entries.filter((entry) => {
+
+			const bufferedEntry = ingestBuffer == null ? undefined : ingestBuffer.get(entry.id)
+
+			if (bufferedEntry == null) return true
+
+			bufferedEntry.updated = new Date(Math.max(bufferedEntry.updated, entry.updated))
+
+			return false
+
+		})
+
+		// The previous durations are required to move the records between the buckets of the histograms
+		const previousEntries = await findDurations(writtenEntries.map((entry) => entry.id))
+		const updates = new Map(entries.map((entry) => [ entry.id, entry.updated ]))
+
+		await writeUpdates(previousEntries.map((entry) => ({ ...entry, updated: updates.get(entry.id) })))
+
+		return durations.track(previousEntries.map((entry) => ({
+			domainId: entry.domainId,
+			created: entry.created,
+			from: durationBucket(entry.created, entry.updated),
+			to: durationBucket(entry.created, Math.max(entry.updated, updates.get(entry.id)))
+		})))
+
+	}
+}) : undefined
+
+const anonymousData = {
+	siteLanguage: null,
+	screenWidth: null,
+	screenHeight: null,
+	screenColorDepth: null,
+	deviceName: null,
+	deviceManufacturer: null,
+	osName: null,
+	osVersion: null,
+	browserName: null,
+	browserVersion: null,
+	browserWidth: null,
+	browserHeight: null
+}
+
+const anonymizeData = (data) => ({ ...data, ...anonymousData, clientId: undefined })
+
+// Checks if a visitor already has a record, except the ignored one
+const isKnownClient = async (clientId, ignoreId) => {
+
+	if (clientId == null) return false
+
+	// Entries that are being inserted might not be found in the collection yet
+	if (ingestBuffer != null) {
+		for (const entry of ingestBuffer.all()) {
+			if (entry.clientId === clientId && entry.id !== ignoreId) return true
+		}
+	}
+
+	const filter = { clientId }
+	if (ignoreId != null) filter.id = { $ne: ignoreId }
+
+	return Record.exists(filter)
+
+}
+
+// Previous records in time-series collections can't be anonymized efficiently. Only the first
+// record of a visitor keeps its clientId and personal data instead of the latest one.
+const anonymizeKnownClient = async (data) => {
+
+	if (timeSeries.enabled === false || await isKnownClient(data.clientId) === false) return data
+
+	return anonymizeData(data)
+
+}
+
+const add = async (input) => {
+
+	const data = await anonymizeKnownClient(input)
+
+	if (ingestBuffer == null) {
+
+		const entry = await create(data)
+
+		sketches.count(entry)
+		durations.track([ {
+			domainId: entry.domainId,
+			created: entry.created,
+			to: 0
+		} ]).catch((err) => signale.fatal(err))
+
+		return entry
+
+	}
+
+	// The id is generated by the schema, so the entry can be returned before it's inserted
+	const entry = validate(data)
+
+	ingestBuffer.set(entry.id, entry)
+	sketches.count(entry)
+
+	return entry
+
+}
+
+const update = async (id) => {
+
+	// Entries that are being inserted are either written or buffered again afterwards
+	if (ingestBuffer != null && ingestBuffer.isFlushing(id) === true) await ingestBuffer.settled()
+
+	const bufferedEntry = ingestBuffer == null ? undefined : ingestBuffer.get(id)
+
+	if (bufferedEntry != null) {
+		bufferedEntry.updated = new Date()
+		return bufferedEntry
+	}
+
+	if (heartbeatBuffer != null) {
+
+		// Respond optimistically without knowing if the record exists
+		const entry = {
+			id,
+			updated: new Date()
+		}
+
+		heartbeatBuffer.set(id, entry)
+
+		return entry
+
+	}
+
+	const updated = new Date()
+
+	if (timeSeries.enabled === true) {
+
+		// The previous duration is required to move the record between the buckets of the histogram
+		const [ entry ] = await findDurations([ id ])
+
+		if (entry == null) return entry
+
+		await writeUpdates([ { ...entry, updated } ])
+
+		durations.track([ {
+			domainId: entry.domainId,
+			created: entry.created,
+			from: durationBucket(entry.created, entry.updated),
+			to: durationBucket(entry.created, Math.max(entry.updated, updated))
+		} ]).catch((err) => signale.fatal(err))
+
+		return { ...entry, updated: new Date(Math.max(entry.updated, updated)) }
+
+	}
+
+	// The previous entry is required to move the record between the buckets of the histogram
+	const entry = await Record.findOneAndUpdate({
+		id
+	}, {
+		$max: {
+			updated
+		}
 	}, {
-		clientId: null,
-		siteLanguage: null,
-		screenWidth: null,
-		screenHeight: null,
-		screenColorDepth: null,
-		deviceName: null,
-		deviceManufacturer: null,
-		osName: null,
-		osVersion: null,
-		browserName: null,
-		browserVersion: null,
-		browserWidth: null,
-		browserHeight: null
+		new: false,
+		// Mongoose would cast the ids of encoded dimensions to strings
+		projection: dictionary.enabled === true ? { id: 1, domainId: 1, created: 1, updated: 1 } : undefined
 	})
 
+	if (entry == null) return entry
+
+	const previousUpdated = entry.updated
+	entry.updated = Math.max(previousUpdated, updated)
+
+	durations.track([ {
+		domainId: entry.domainId,
+		created: entry.created,
+		from: durationBucket(entry.created, previousUpdated),
+		to: durationBucket(entry.created, entry.updated)
+	} ]).catch((err) => signale.fatal(err))
+
+	return entry
+
+}
+
+// Adds and updates multiple records with one bulk write. All new records are validated first.
+// Invalid records are returned as their validation errors and don't prevent the others from being added.
+const batch = async (data, ids) => {
+
+	const updated = new Date()
+	const clientIds = new Set()
+
+	// Only the first record of a visitor in the batch can keep its clientId
+	const items = (await Promise.all(data.map(anonymizeKnownClient))).map((item) => {
+
+		if (timeSeries.enabled === false || item.clientId == null) return item
+		if (clientIds.has(item.clientId) === true) return anonymizeData(item)
+
+		clientIds.add(item.clientId)
+
+		return item
+
+	})
+
+	const created = items.map((item) => {
+		try {
+			return validate(item)
+		} catch (err) {
+			return err
+		}
+	})
+
+	const entries = created.filter((entry) => entry instanceof Error === false)
+
+	entries.forEach((entry) => sketches.count(entry))
+
+	// Buffered entries are inserted and tracked by the buffer
+	if (ingestBuffer != null) entries.forEach((entry) => ingestBuffer.set(entry.id, entry))
+
+	// Entries that are being inserted are either written or buffered again afterwards
+	if (ingestBuffer != null && ids.some(ingestBuffer.isFlushing) === true) await ingestBuffer.settled()
+
+	const results = new Map()
+	const pendingIds = []
+
+	ids.forEach((id) => {
+
+		const bufferedEntry = ingestBuffer == null ? undefined : ingestBuffer.get(id)
+
+		if (bufferedEntry != null) {
+			bufferedEntry.updated = updated
+			return results.set(id, bufferedEntry)
+		}
+
+		if (heartbeatBuffer != null) {
+			const entry = { id, updated }
+			heartbeatBuffer.set(id, entry)
+			return results.set(id, entry)
+		}
+
+		pendingIds.push(id)
+
+	})
+
+	// The previous durations are required to move the records between the buckets of the histograms
+	const previousEntries = pendingIds.length === 0 ? [] : await findDurations(pendingIds)
+
+	const documents = ingestBuffer != null ? [] : dictionary.enabled === true ? await Promise.all(entries.map(dictionary.encode)) : entries
+
+	const operations = [
+		...documents.map((document) => ({
+			insertOne: {
+				document
+			}
+		})),
+		...(timeSeries.enabled === true ? [] : previousEntries).map((entry) => ({
+			updateOne: {
+				filter: {
+					id: entry.id
+				},
+				update: {
+					$max: {
+						updated
+					}
+				}
+			}
+		}))
+	]
+
+	// Written without mongoose, which would cast the ids of encoded dimensions to strings
+	if (operations.length > 0) await Record.collection.bulkWrite(operations, { ordered: false })
+	if (documents.length > 0) await bumpVersions(entries)
+	if (timeSeries.enabled === true) await writeUpdates(previousEntries.map((entry) => ({ ...entry, updated })))
+
+	previousEntries.forEach((entry) => results.set(entry.id, {
+		...entry,
+		updated: new Date(Math.max(entry.updated, updated))
+	}))
+
+	durations.track([
+		...(ingestBuffer != null ? [] : entries.map((entry) => ({
+			domainId: entry.domainId,
+			created: entry.created,
+			to: 0
+		}))),
+		...previousEntries.map((entry) => ({
+			domainId: entry.domainId,
+			created: entry.created,
+			from: durationBucket(entry.created, entry.updated),
+			to: durationBucket(entry.created, Math.max(entry.updated, updated))
+		}))
+	]).catch((err) => signale.fatal(err))
+
+	return {
+		created,
+		updated: ids.map((id) => results.get(id))
+	}
+
+}
+
+// Removes the clientId and personal data from all records of a visitor except the ignored one
+const anonymizeClient = async (clientId, ignoreId) => {
+
+	const filter = {
+		clientId,
+		id: {
+			$ne: ignoreId
+		}
+	}
+
+	// The summaries of the top values must forget the anonymized values
+	const anonymizedEntries = sketches.enabled === true ? await Promise.all((await Record.find(filter).lean()).map(dictionary.decodeRecord)) : []
+	anonymizedEntries.forEach((anonymizedEntry) => sketches.count(anonymizedEntry, -1, Object.keys(anonymousData)))
+
+	return Record.updateMany(filter, {
+		$set: anonymousData,
+		$unset: {
+			clientId: 1
+		}
+	})
+
+}
+
+const anonymizeEntry = async (entry) => {
+
+	try {
+
+		const result = await anonymizeClient(entry.clientId, entry.ignoreId)
+
+		entry.resolve({
+			...result,
+			nModified: result.nModified + entry.bufferedCount
+		})
+
+	} catch (err) {
+
+		signale.warn(`Failed to anonymize records, retrying with the next batch: ${ err.message }`)
+
+		// Nothing matches the clientId after the salt changed, so failed entries must not be dropped.
+		// A newer call of the same visitor also anonymizes the record ignored by this one.
+		const nextEntry = anonymizeBuffer.get(entry.clientId)
+
+		if (nextEntry == null) return anonymizeBuffer.set(entry.clientId, entry)
+
+		nextEntry.bufferedCount += entry.bufferedCount
+		entry.resolve({ nModified: 0 })
+
+	}
+
+}
+
+// Anonymization runs in batches in the background to keep it out of the ingest path.
+// Consecutive calls with the same clientId are handled by a single update.
+const anonymizeBuffer = createBuffer({
+	size: 1000,
+	interval: anonymizeInterval,
+	flush: async (entries) => {
+
+		// Records of a running ingest flush must exist before they can be anonymized
+		if (ingestBuffer != null) await ingestBuffer.flush()
+
+		return Promise.all(entries.map(anonymizeEntry))
+
+	}
+})
+
+// Anonymizes the previous records of all visitors, e.g. when pending anonymizations were lost
+// because the process stopped unexpectedly. Runs after the salt changed, so the latest record
+// of each visitor can't get new records anymore and keeps its clientId like it would otherwise.
+const sweep = async () => {
+
+	// Records in time-series collections have been anonymized when they were added
+	if (timeSeries.enabled === true) return 0
+
+	const clients = await Record.aggregate(aggregateDuplicateClients()).allowDiskUse(true)
+	const results = await mapLimit(clients, 10, (client) => anonymizeClient(client._id, client.latestId))
+
+	return results.reduce((acc, result) => acc + result.nModified, 0)
+
+}
+
+// Records in time-series collections have been anonymized when they were added
+const anonymizeTimeSeries = async (clientId, ignoreId) => ({
+	nModified: await isKnownClient(clientId, ignoreId) === true ? 1 : 0
+})
+
+const anonymizeRecords = (clientId, ignoreId) => new Promise((resolve, reject) => {
+
+	let bufferedCount = 0
+
+	// Buffered entries haven't been inserted yet and must be anonymized in place
+	if (ingestBuffer != null) {
+		for (const entry of ingestBuffer.values()) {
+			if (entry.clientId !== clientId || entry.id === ignoreId) continue
+			sketches.count(entry, -1, Object.keys(anonymousData))
+			// The driver would store undefined values as null
+			Object.assign(entry, anonymousData)
+			delete entry.clientId
+			bufferedCount++
+		}
+	}
+
+	const previousEntry = anonymizeBuffer.get(clientId)
+
+	// The update of the current call will include the entries of the previous one.
+	// Its entries will be counted by the current call.
+	if (previousEntry != null) {
+		bufferedCount += previousEntry.bufferedCount
+		previousEntry.resolve({ nModified: 0 })
+	}
+
+	anonymizeBuffer.set(clientId, {
+		clientId,
+		ignoreId,
+		bufferedCount,
+		resolve,
+		reject
+	})
+
+})
+
+const anonymize = (clientId, ignoreId) => {
+
+	return timeSeries.enabled === true ? anonymizeTimeSeries(clientId, ignoreId) : anonymizeRecords(clientId, ignoreId)
+
+}
+
+// Returns a cursor that fetches the records of a domain in batches while they're read.
+// clientIds are omitted as they would allow to reconstruct the browsing history of a user.
+const stream = (domainId, from, to) => {
+
+	const filter = {
+		domainId
+	}
+
+	if (from != null || to != null) {
+		filter.created = {}
+		if (from != null) filter.created.$gte = from
+		if (to != null) filter.created.$lt = to
+	}
+
+	const projection = {
+		_id: 0,
+		__v: 0,
+		clientId: 0
+	}
+
+	// Durations of records in time-series collections end with their latest heartbeat
+	if (timeSeries.enabled === true) return Record.aggregate([
+		{ $match: filter },
+		{ $sort: { created: 1 } },
+		...aggregateRecordHeartbeats(Heartbeat.collection.collectionName),
+		{ $project: projection }
+	]).cursor({ batchSize: 1000 }).exec()
+
+	return Record.find(filter, projection).sort({
+		created: 1
+	}).lean().batchSize(1000).cursor()
+
+}
+
+// Stores the day of records that have been added before they were stored or with
+// another time zone. Encodes or decodes their dimensions depending on the storage mode.
+// Only records with different values are updated.
+const backfill = async () => {
+
+	// Records in time-series collections get their day when they're migrated
+	if (timeSeries.enabled === true) return 0
+
+	const cursor = Record.find({}, dictionary.properties.reduce((acc, property) => {
+		acc[property] = 1
+		return acc
+	}, {
+		created: 1,
+		day: 1
+	})).lean().batchSize(1000).cursor()
+
+	let updates = []
+	let count = 0
+
+	// Written without mongoose, which would cast the ids of dimensions to strings
+	const write = async () => {
+		await Record.collection.bulkWrite(updates, { ordered: false })
+		count += updates.length
+		updates = []
+	}
+
+	for (let record = await cursor.next(); record != null; record = await cursor.next()) {
+
+		const { _id, ...data } = record
+		const converted = dictionary.enabled === true ? await dictionary.encode(data) : await dictionary.decodeRecord(data)
+
+		converted.day = dayKey(record.created)
+
+		const changes = Object.keys(converted).filter((key) => converted[key] !== record[key])
+
+		if (changes.length === 0) continue
+
+		updates.push({
+			updateOne: {
+				filter: { _id },
+				update: {
+					$set: changes.reduce((acc, key) => {
+						acc[key] = converted[key]
+						return acc
+					}, {})
+				}
+			}
+		})
+
+		if (updates.length >= 1000) await write()
+
+	}
+
+	if (updates.length > 0) await write()
+
+	return count
+
+}
+
+// Creates the time-series collections of records and heartbeats before anything is written
+const prepare = async () => {
+
+	if (timeSeries.enabled === false) return
+
+	await timeSeries.create(Record, 'created')
+	await timeSeries.create(Heartbeat, 'updated')
+
+}
+
+// Number of entries that haven't been written yet
+const buffers = () => ({
+	ingest: ingestBuffer == null ? 0 : ingestBuffer.size(),
+	heartbeat: heartbeatBuffer == null ? 0 : heartbeatBuffer.size(),
+	anonymize: anonymizeBuffer.size(),
+	sketch: sketches.buffered()
+})
+
+// Writes all buffers before the process exits. Failed entries get a few more attempts.
+const drain = async (buffer, name) => {
+
+	if (buffer == null) return
+
+	const count = await buffer.drain()
+
+	if (count > 0) signale.fatal(`Failed to write ${ count } buffered ${ name }`)
+
+}
+
+const flush = async () => {
+
+	await drain(ingestBuffer, 'records')
+	await drain(heartbeatBuffer, 'heartbeats')
+	await drain(anonymizeBuffer, 'anonymizations')
+	await sketches.flush()
+
 }
 
 module.exports = {
 	add,
 	update,
-	anonymize
-}
\ No newline at end of file
+	batch,
+	anonymize,
+	sweep,
+	stream,
+	backfill,
+	prepare,
+	buffers,
+	flush
+}
@@ -1,39 +1,47 @@
 'use strict'
 
 const Record = require('../schemas/Record')
+const sketches = require('./sketches')
+const dictionary = require('./dictionary')
 const aggregateTopFields = require('../aggregations/aggregateTopFields')
 const aggregateRecentFields = require('../aggregations/aggregateRecentFields')
 const aggregateNewFields = require('../aggregations/aggregateNewFields')
 const constants = require('../constants/referrers')
+const metrics = require('../constants/metrics')
+const cacheResult = require('../utils/cacheResult')
+const sampling = require('../utils/sampling')
+const analytics = require('../utils/analytics')
 
-const getTop = async (id, range) => {
+const getTop = cacheResult(metrics.METRICS_REFERRERS, 'top', async (id, range, accuracy) => {
 
-	return Record.aggregate(
-		aggregateTopFields(id, 'siteReferrer', range)
-	)
+	if (sketches.enabled === true) return sketches.getTop(id, [ 'siteReferrer' ], range)
 
-}
+	return dictionary.decode([ 'siteReferrer' ], await analytics.model(Record).aggregate(
+		aggregateTopFields(id, 'siteReferrer', range, sampling(accuracy))
+	))
+
+})
 
-const getNew = async (id) => {
+const getNew = cacheResult(metrics.METRICS_REFERRERS, 'new', async (id) => {
 
-	return Record.aggregate(
+	return dictionary.decode([ 'siteReferrer' ], await analytics.model(Record).aggregate(
 		aggregateNewFields(id, 'siteReferrer')
-	)
+	))
 
-}
+})
 
 const getRecent = async (id) => {
 
-	return Record.aggregate(
+	return dictionary.decode([ 'siteReferrer' ], await analytics.model(Record).aggregate(
 		aggregateRecentFields(id, 'siteReferrer')
-	)
+	))
 
 }
 
-const get = async (id, sorting, range) => {
+const get = async (id, sorting, range, accuracy) => {
 
 	switch (sorting) {
-		case constants.REFERRERS_SORTING_TOP: return getTop(id, range)
+		case constants.REFERRERS_SORTING_TOP: return getTop(id, range, accuracy)
 		case constants.REFERRERS_SORTING_NEW: return getNew(id)
 		case constants.REFERRERS_SORTING_RECENT: return getRecent(id)
 	}
@@ -0,0 +1,99 @@
+'use strict'
+
+const Record = require('../schemas/Record')
+const Heartbeat = require('../schemas/Heartbeat')
+const domains = require('./domains')
+const views = require('./views')
+const durations = require('./durations')
+const sketches = require('./sketches')
+const startOfDay = require('../utils/startOfDay')
+const versions = require('../utils/versions')
+const timeSeries = require('../utils/timeSeries')
+const { day } = require('../utils/times')
+
+const days = Number.parseInt(process.env.ACKEE_RETENTION_DAYS)
+const enabled = days > 0
+const batchSize = 1000
+
+// Removes the matching records in small batches to keep the load on the database low
+const remove = async (filter) => {
+
+	// Time-series collections remove whole buckets of the domain and the range at once.
+	// Heartbeats store the domain and the creation of their record, so they match the same filter.
+	if (timeSeries.enabled === true) {
+		const result = await Record.deleteMany(filter)
+		await Heartbeat.deleteMany(filter)
+		return result.deletedCount
+	}
+
+	let count = 0
+
+	while (true) {
+
+		const entries = await Record.find(filter, { _id: 1 }).limit(batchSize).lean()
+
+		if (entries.length === 0) return count
+
+		await Record.deleteMany({
+			_id: {
+				$in: entries.map((entry) => entry._id)
+			}
+		})
+
+		count += entries.length
+
+		if (entries.length < batchSize) return count
+
+	}
+
+}
+
+// Removes records that are older than the retention window. Their data stays available in the
+// rollups of views, durations and top values, which are built first when they're missing.
+const prune = async () => {
+
+	if (enabled === false) return 0
+
+	// Removing records without summaries would lose their top values
+	if (sketches.enabled === false) throw new Error('Retention requires summaries of top values')
+
+	const now = new Date()
+
+	// Only whole days of the reporting time zone are removed so the rollups of the remaining days stay complete
+	const before = startOfDay(new Date(now.getTime() - days * day))
+
+	const entries = await domains.all()
+	let count = 0
+
+	// Each domain uses the index of domainId and created
+	for (const entry of entries) {
+
+		const filter = {
+			domainId: entry.id,
+			created: {
+				$lt: before
+			}
+		}
+
+		await views.fold(filter)
+		await durations.fold(filter)
+		await sketches.fold(filter)
+
+		const removed = await remove(filter)
+
+		// Results of the top values change when records are removed
+		if (removed > 0) await versions.bump(entry.id)
+
+		count += removed
+
+	}
+
+	return count
+
+}
+
+module.exports = {
+	enabled,
+	days,
+	prune
+}
@@ -1,67 +1,84 @@
 'use strict'
 
 const Record = require('../schemas/Record')
+const sketches = require('./sketches')
 const aggregateTopFields = require('../aggregations/aggregateTopFields')
 const aggregateTopFieldsMultiple = require('../aggregations/aggregateTopFieldsMultiple')
 const constants = require('../constants/sizes')
+const metrics = require('../constants/metrics')
+const cacheResult = require('../utils/cacheResult')
+const sampling = require('../utils/sampling')
+const analytics = require('../utils/analytics')
 
-const getBrowserWidth = async (id, range) => {
+const getBrowserWidth = cacheResult(metrics.METRICS_SIZES, 'browserWidth', async (id, range, accuracy) => {
 
-	return Record.aggregate(
-		aggregateTopFields(id, 'browserWidth', range)
+	if (sketches.enabled === true) return sketches.getTop(id, [ 'browserWidth' ], range)
+
+	return analytics.model(Record).aggregate(
+		aggregateTopFields(id, 'browserWidth', range, sampling(accuracy))
 	)
 
-}
+})
+
+const getBrowserHeight = cacheResult(metrics.METRICS_SIZES, 'browserHeight', async (id, range, accuracy) => {
 
-const getBrowserHeight = async (id, range) => {
+	if (sketches.enabled === true) return sketches.getTop(id, [ 'browserHeight' ], range)
 
-	return Record.aggregate(
-		aggregateTopFields(id, 'browserHeight', range)
+	return analytics.model(Record).aggregate(
+		aggregateTopFields(id, 'browserHeight', range, sampling(accuracy))
 	)
 
-}
+})
+
+const getBrowserResolution = cacheResult(metrics.METRICS_SIZES, 'browserResolution', async (id, range, accuracy) => {
 
-const getBrowserResolution = async (id, range) => {
+	if (sketches.enabled === true) return sketches.getTop(id, [ 'browserWidth', 'browserHeight' ], range)
 
-	return Record.aggregate(
-		aggregateTopFieldsMultiple(id, [ 'browserWidth', 'browserHeight' ], range)
+	return analytics.model(Record).aggregate(
+		aggregateTopFieldsMultiple(id, [ 'browserWidth', 'browserHeight' ], range, sampling(accuracy))
 	)
 
-}
+})
 
-const getScreenWidth = async (id, range) => {
+const getScreenWidth = cacheResult(metrics.METRICS_SIZES, 'screenWidth', async (id, range, accuracy) => {
 
-	return Record.aggregate(
-		aggregateTopFields(id, 'screenWidth', range)
+	if (sketches.enabled === true) return sketches.getTop(id, [ 'screenWidth' ], range)
+
+	return analytics.model(Record).aggregate(
+		aggregateTopFields(id, 'screenWidth', range, sampling(accuracy))
 	)
 
-}
+})
+
+const getScreenHeight = cacheResult(metrics.METRICS_SIZES, 'screenHeight', async (id, range, accuracy) => {
 
-const getScreenHeight = async (id, range) => {
+	if (sketches.enabled === true) return sketches.getTop(id, [ 'screenHeight' ], range)
 
-	return Record.aggregate(
-		aggregateTopFields(id, 'screenHeight', range)
+	return analytics.model(Record).aggregate(
+		aggregateTopFields(id, 'screenHeight', range, sampling(accuracy))
 	)
 
-}
+})
+
+const getScreenResolution = cacheResult(metrics.METRICS_SIZES, 'screenResolution', async (id, range, accuracy) => {
 
-const getScreenResolution = async (id, range) => {
+	if (sketches.enabled === true) return sketches.getTop(id, [ 'screenWidth', 'screenHeight' ], range)
 
-	return Record.aggregate(
-		aggregateTopFieldsMultiple(id, [ 'screenWidth', 'screenHeight' ], range)
+	return analytics.model(Record).aggregate(
+		aggregateTopFieldsMultiple(id, [ 'screenWidth', 'screenHeight' ], range, sampling(accuracy))
 	)
 
-}
+})
 
-const get = async (id, type, range) => {
+const get = async (id, type, range, accuracy) => {
 
 	switch (type) {
-		case constants.SIZES_TYPE_BROWSER_HEIGHT: return getBrowserHeight(id, range)
-		case constants.SIZES_TYPE_BROWSER_RESOLUTION: return getBrowserResolution(id, range)
-		case constants.SIZES_TYPE_BROWSER_WIDTH: return getBrowserWidth(id, range)
-		case constants.SIZES_TYPE_SCREEN_HEIGHT: return getScreenHeight(id, range)
-		case constants.SIZES_TYPE_SCREEN_RESOLUTION: return getScreenResolution(id, range)
-		case constants.SIZES_TYPE_SCREEN_WIDTH: return getScreenWidth(id, range)
+		case constants.SIZES_TYPE_BROWSER_HEIGHT: return getBrowserHeight(id, range, accuracy)
+		case constants.SIZES_TYPE_BROWSER_RESOLUTION: return getBrowserResolution(id, range, accuracy)
+		case constants.SIZES_TYPE_BROWSER_WIDTH: return getBrowserWidth(id, range, accuracy)
+		case constants.SIZES_TYPE_SCREEN_HEIGHT: return getScreenHeight(id, range, accuracy)
+		case constants.SIZES_TYPE_SCREEN_RESOLUTION: return getScreenResolution(id, range, accuracy)
+		case constants.SIZES_TYPE_SCREEN_WIDTH: return getScreenWidth(id, range, accuracy)
 	}
 
 }
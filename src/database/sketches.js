@@ -0,0 +1,404 @@
+'use strict'
+
+const Record = require('../schemas/Record')
+const Sketch = require('../schemas/Sketch')
+const dictionary = require('./dictionary')
+const aggregateTopSketches = require('../aggregations/aggregateTopSketches')
+const aggregateSketchRollups = require('../aggregations/aggregateSketchRollups')
+const createBuffer = require('../utils/createBuffer')
+const spaceSaving = require('../utils/spaceSaving')
+const mapLimit = require('../utils/mapLimit')
+const dayKey = require('../utils/dayKey')
+const dayIndex = require('../utils/dayIndex')
+const dyadicBlocks = require('../utils/dyadicBlocks')
+const signale = require('../utils/signale')
+const analytics = require('../utils/analytics')
+const versions = require('../utils/versions')
+
+const size = Number.parseInt(process.env.ACKEE_SKETCH_SIZE)
+const interval = Number.parseInt(process.env.ACKEE_SKETCH_INTERVAL) || 10000
+const enabled = size > 0
+
+// Summaries are compacted right away once they have more pending values, so they can't grow indefinitely
+const pendingLimit = size * 10
+
+// All dimensions used by the top sorting of the metrics
+const dimensions = [
+	[ 'siteLocation' ],
+	[ 'siteReferrer' ],
+	[ 'siteLanguage' ],
+	[ 'screenWidth' ],
+	[ 'screenHeight' ],
+	[ 'screenWidth', 'screenHeight' ],
+	[ 'browserWidth' ],
+	[ 'browserHeight' ],
+	[ 'browserWidth', 'browserHeight' ],
+	[ 'deviceManufacturer' ],
+	[ 'deviceManufacturer', 'deviceName' ],
+	[ 'osName' ],
+	[ 'osName', 'osVersion' ],
+	[ 'browserName' ],
+	[ 'browserName', 'browserVersion' ]
+]
+
+// Days of the summaries of the blocks that contain a day
+const blockDays = (day) => dyadicBlocks.containing(dayIndex(day)).map((block) => ({
+	level: block.level,
+	day: dayIndex.toDayKey(block.start)
+}))
+
+// Summaries of a day and of all blocks containing it
+const levelDays = (day) => [ { level: 0, day }, ...blockDays(day) ]
+
+// Deltas of an entry for one of its summaries. Deltas of a failed write only belong to their summary.
+const levelDeltas = (entry, level) => {
+
+	const deltas = new Map()
+	const add = (delta, key) => {
+		const existing = deltas.get(key)
+		deltas.set(key, { value: delta.value, count: (existing == null ? 0 : existing.count) + delta.count })
+	}
+
+	if (entry.retries.has(level) === true) entry.retries.get(level).forEach(add)
+	entry.deltas.forEach(add)
+
+	return deltas
+
+}
+
+// Adds the deltas to the pending values of the summaries. Returns the failed writes with their error.
+// Changes the version so that a compaction that read the summary before doesn't remove them.
+const push = async (targets) => {
+
+	try {
+
+		await Sketch.bulkWrite(targets.map(({ entry, level, day, deltas }) => ({
+			updateOne: {
+				filter: { domainId: entry.domainId, day, level, dimension: entry.dimension },
+				update: {
+					$push: { pending: { $each: [ ...deltas.values() ].map(({ value, count }) => ({ value, count })) } },
+					$set: { hasPending: true },
+					$inc: { pendingCount: deltas.size, version: 1 },
+					$setOnInsert: { counters: [] }
+				},
+				upsert: true
+			}
+		})), {
+			ordered: false
+		})
+
+		return []
+
+	} catch (err) {
+
+		const writeErrors = err.writeErrors || (err.result != null && typeof err.result.getWriteErrors === 'function' ? err.result.getWriteErrors() : undefined)
+
+		if (writeErrors == null || writeErrors.length === 0) throw err
+
+		return writeErrors.map((writeError) => ({ target: targets[writeError.index], writeError }))
+
+	}
+
+}
+
+// Several processes can create the same summary at once. It exists when the write is repeated.
+const pushAll = async (targets) => {
+
+	const failures = await push(targets)
+	const duplicates = failures.filter(({ writeError }) => writeError.code === 11000).map(({ target }) => target)
+
+	if (duplicates.length === 0) return failures
+
+	return [ ...failures.filter(({ writeError }) => writeError.code !== 11000), ...await push(duplicates) ]
+
+}
+
+// Counts the values of all records of an interval in memory and adds them to the summaries with one
+// write, without reading them. The primary truncates the summaries to their size every minute and
+// summaries with too many pending values are truncated right away (see compact).
+// Cached top values of the domains are outdated once the summaries have been written.
+const buffer = enabled === true ? createBuffer({
+	interval,
+	flush: async (entries) => {
+
+		const targets = entries.reduce((acc, entry) => acc.concat(levelDays(entry.day).map(({ level, day }) => ({
+			entry,
+			level,
+			day,
+			deltas: levelDeltas(entry, level)
+		}))), []).filter((target) => target.deltas.size > 0)
+
+		if (targets.length === 0) return
+
+		const failures = await pushAll(targets)
+
+		await Promise.all([ ...new Set(entries.map((entry) => entry.domainId)) ].map(versions.bump))
+
+		await compactOverfull().catch((err) => signale.warn(`Failed to compact summaries of top values: ${ err.message }`))
+
+		if (failures.length === 0) return
+
+		// Only the failed summaries of an entry are retried, so no value is counted twice
+		const failedEntries = [ ...new Set(failures.map(({ target }) => target.entry)) ]
+
+		failedEntries.forEach((entry) => {
+			entry.retries = new Map(failures.filter(({ target }) => target.entry === entry).map(({ target }) => [ target.level, target.deltas ]))
+			entry.deltas = new Map()
+		})
+
+		throw Object.assign(new Error(failures[0].writeError.errmsg), { entries: failedEntries })
+
+	}
+}) : undefined
+
+// Counts the values of a record. A negative weight removes the values of the given properties,
+// e.g. when they've been anonymized.
+const count = (record, weight = 1, properties) => {
+
+	if (enabled === false) return
+
+	const day = dayKey(record.created)
+
+	dimensions.forEach((dimension) => {
+
+		if (properties != null && dimension.some((property) => properties.includes(property)) === false) return
+		if (dimension.some((property) => record[property] == null)) return
+
+		const value = dimension.length === 1 ? record[dimension[0]] : dimension.reduce((acc, property) => {
+			acc[property] = record[property]
+			return acc
+		}, {})
+
+		const key = `${ record.domainId }:${ day }:${ dimension.join(',') }`
+		const entry = buffer.get(key) || { domainId: record.domainId, day, dimension: dimension.join(','), deltas: new Map(), retries: new Map() }
+		const valueKey = JSON.stringify(value)
+		const delta = entry.deltas.get(valueKey) || { value, count: 0 }
+
+		delta.count += weight
+		entry.deltas.set(valueKey, delta)
+		buffer.set(key, entry)
+
+	})
+
+}
+
+// Summaries of blocks merge the summaries of their days
+const mergeBlocks = (entries) => {
+
+	const blocks = new Map()
+
+	entries.forEach((entry) => blockDays(entry.day).forEach(({ level, day }) => {
+
+		const key = `${ entry.domainId }:${ entry.dimension }:${ level }:${ day }`
+		const block = blocks.get(key) || { domainId: entry.domainId, day, level, dimension: entry.dimension, counters: [], version: 0 }
+
+		block.counters = spaceSaving(block.counters, entry.counters, size)
+		blocks.set(key, block)
+
+	}))
+
+	return [ ...blocks.values() ]
+
+}
+
+// Adds the values of summaries of days to the summaries of their blocks, the same way as new values
+const foldBlocks = async (entries) => {
+
+	const targets = mergeBlocks(entries).map((block) => ({
+		entry: block,
+		level: block.level,
+		day: block.day,
+		deltas: new Map(block.counters.map((counter) => [ JSON.stringify(counter.value), counter ]))
+	}))
+
+	if (targets.length === 0) return
+
+	const failures = await pushAll(targets)
+
+	if (failures.length > 0) throw new Error(`Failed to fold summaries of top values: ${ failures[0].writeError.errmsg }`)
+
+	await compactOverfull()
+
+}
+
+const write = (entries, replace) => Sketch.bulkWrite(entries.map(({ domainId, day, level, dimension, ...data }) => (replace === true ? {
+	replaceOne: {
+		filter: { domainId, day, level, dimension },
+		replacement: { domainId, day, level, dimension, ...data },
+		upsert: true
+	}
+} : {
+	updateOne: {
+		filter: { domainId, day, level, dimension },
+		update: { $setOnInsert: data },
+		upsert: true
+	}
+})), {
+	ordered: false
+})
+
+// Builds the summaries of all matching records. Existing summaries are either replaced
+// or kept when they already include the records. Blocks that are kept receive the values
+// of the days that didn't have a summary yet.
+const rollup = async (filter, replace) => {
+
+	if (enabled === false) return 0
+
+	const counts = await mapLimit(dimensions, 1, async (properties) => {
+
+		const entries = await Record.aggregate([
+			{
+				$match: filter
+			},
+			...aggregateSketchRollups(properties, size)
+		]).allowDiskUse(true)
+
+		// No need to continue when there're no entries
+		if (entries.length === 0) return 0
+
+		// Summaries contain the values of encoded dimensions instead of their ids
+		const decodedEntries = await mapLimit(entries, 10, async (entry) => ({
+			...entry,
+			level: 0,
+			counters: await dictionary.decode(properties, entry.counters, 'value')
+		}))
+
+		if (replace === true) {
+			await write([ ...decodedEntries, ...mergeBlocks(decodedEntries) ], true)
+			return entries.length
+		}
+
+		const result = await write(decodedEntries, false)
+		const insertedEntries = Object.keys(result.upsertedIds || {}).map((index) => decodedEntries[index])
+
+		await foldBlocks(insertedEntries)
+
+		return entries.length
+
+	})
+
+	return counts.reduce((acc, count) => acc + count, 0)
+
+}
+
+const backfill = () => rollup({}, true)
+
+// Merges the pending values into the counters, which keeps each summary at `size` counters
+const compactSketch = async (_id) => {
+
+	// Retry until no other process added values or compacted the summary in the meantime
+	while (true) {
+
+		const sketch = await Sketch.findById(_id).lean()
+
+		if (sketch == null || sketch.hasPending !== true) return 0
+
+		const result = await Sketch.updateOne({
+			_id,
+			version: sketch.version
+		}, {
+			$set: {
+				counters: spaceSaving(sketch.counters, sketch.pending || [], size),
+				pending: [],
+				pendingCount: 0,
+				hasPending: false
+			},
+			$inc: {
+				version: 1
+			}
+		})
+
+		if (result.nModified === 1) return 1
+
+	}
+
+}
+
+const compactAll = async (filter) => {
+
+	const sketches = await Sketch.find({ hasPending: true, ...filter }, { _id: 1 }).lean()
+	const counts = await mapLimit(sketches, 10, (sketch) => compactSketch(sketch._id))
+
+	return counts.reduce((acc, count) => acc + count, 0)
+
+}
+
+// Compacts the summaries that exceeded the limit of pending values
+const compactOverfull = () => compactAll({ pendingCount: { $gt: pendingLimit } })
+
+// Compacts all summaries with pending values. Runs on the primary only.
+const compact = async () => {
+
+	if (enabled === false) return 0
+
+	return compactAll({})
+
+}
+
+// Summaries of older versions don't have a level and were unique per day. Blocks start on the
+// same day as the summary of their first day, so the old index must be removed before they're built.
+const migrate = async () => {
+
+	const result = await Sketch.updateMany({ level: { $exists: false } }, { $set: { level: 0 } })
+
+	try {
+		await Sketch.collection.dropIndex('domainId_1_dimension_1_day_-1')
+	} catch (err) {
+		// The index or the collection doesn't exist
+		if (err.codeName !== 'IndexNotFound' && err.codeName !== 'NamespaceNotFound') throw err
+	}
+
+	if (result.nModified === 0) return 0
+
+	await Sketch.init()
+
+	// Blocks are built from the daily summaries of each domain and dimension
+	const groups = await Sketch.aggregate([
+		{ $match: { level: 0 } },
+		{ $group: { _id: { domainId: '$domainId', dimension: '$dimension' } } }
+	])
+
+	await mapLimit(groups, 1, async ({ _id }) => {
+		const entries = await Sketch.find({ ..._id, level: 0 }, { _id: 0 }).lean()
+		await write(mergeBlocks(entries), true)
+	})
+
+	return result.nModified
+
+}
+
+// Makes sure that the summaries include the matching records before they're removed
+const fold = (filter) => rollup(filter, false)
+
+const getTop = async (id, properties, range) => {
+
+	return analytics.model(Sketch).aggregate(
+		aggregateTopSketches(id, properties.join(','), range)
+	)
+
+}
+
+const buffered = () => buffer == null ? 0 : buffer.size()
+
+// Failed entries get a few more attempts before the process exits
+const flush = async () => {
+
+	if (buffer == null) return
+
+	const count = await buffer.drain()
+
+	if (count > 0) signale.fatal(`Failed to write ${ count } buffered summaries of top values`)
+
+}
+
+module.exports = {
+	enabled,
+	count,
+	getTop,
+	backfill,
+	migrate,
+	fold,
+	compact,
+	buffered,
+	flush
+}
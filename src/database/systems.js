@@ -1,46 +1,56 @@
 'use strict'
 
 const Record = require('../schemas/Record')
+const sketches = require('./sketches')
+const dictionary = require('./dictionary')
 const aggregateRecentFieldsMultiple = require('../aggregations/aggregateRecentFieldsMultiple')
 const aggregateTopFieldsMultiple = require('../aggregations/aggregateTopFieldsMultiple')
 const aggregateTopFields = require('../aggregations/aggregateTopFields')
 const aggregateRecentFields = require('../aggregations/aggregateRecentFields')
 const constants = require('../constants/systems')
+const metrics = require('../constants/metrics')
+const cacheResult = require('../utils/cacheResult')
+const sampling = require('../utils/sampling')
+const analytics = require('../utils/analytics')
 
-const getTopWithVersion = async (id, range) => {
+const getTopWithVersion = cacheResult(metrics.METRICS_SYSTEMS, 'topWithVersion', async (id, range, accuracy) => {
 
-	return Record.aggregate(
-		aggregateTopFieldsMultiple(id, [ 'osName', 'osVersion' ], range)
-	)
-}
+	if (sketches.enabled === true) return sketches.getTop(id, [ 'osName', 'osVersion' ], range)
+
+	return dictionary.decode([ 'osName', 'osVersion' ], await analytics.model(Record).aggregate(
+		aggregateTopFieldsMultiple(id, [ 'osName', 'osVersion' ], range, sampling(accuracy))
+	))
+})
 
 const getRecentWithVersion = async (id) => {
 
-	return Record.aggregate(
+	return dictionary.decode([ 'osName', 'osVersion' ], await analytics.model(Record).aggregate(
 		aggregateRecentFieldsMultiple(id, [ 'osName', 'osVersion' ])
-	)
+	))
 }
 
-const getTopNoVersion = async (id, range) => {
+const getTopNoVersion = cacheResult(metrics.METRICS_SYSTEMS, 'topNoVersion', async (id, range, accuracy) => {
 
-	return Record.aggregate(
-		aggregateTopFields(id, 'osName', range)
-	)
-}
+	if (sketches.enabled === true) return sketches.getTop(id, [ 'osName' ], range)
+
+	return dictionary.decode([ 'osName' ], await analytics.model(Record).aggregate(
+		aggregateTopFields(id, 'osName', range, sampling(accuracy))
+	))
+})
 
 const getRecentNoVersion = async (id) => {
 
-	return Record.aggregate(
+	return dictionary.decode([ 'osName' ], await analytics.model(Record).aggregate(
 		aggregateRecentFields(id, 'osName')
-	)
+	))
 }
 
 
-const get = async (id, sorting, type, range) => {
+const get = async (id, sorting, type, range, accuracy) => {
 
 	switch (sorting) {
 		case constants.SYSTEMS_SORTING_TOP:
-			return type === constants.SYSTEMS_TYPE_NO_VERSION ? getTopNoVersion(id, range) : getTopWithVersion(id, range)
+			return type === constants.SYSTEMS_TYPE_NO_VERSION ? getTopNoVersion(id, range, accuracy) : getTopWithVersion(id, range, accuracy)
 		case constants.SYSTEMS_SORTING_RECENT:
 			return type === constants.SYSTEMS_TYPE_NO_VERSION ? getRecentNoVersion(id) : getRecentWithVersion(id)
 	}
@@ -2,6 +2,17 @@
 
 const Token = require('../schemas/Token')
 const runUpdate = require('../utils/runUpdate')
+const createCache = require('../utils/createCache')
+const { second } = require('../utils/times')
+
+const cacheTtl = process.env.ACKEE_TOKEN_CACHE_TTL == null ? second * 10 : Number.parseInt(process.env.ACKEE_TOKEN_CACHE_TTL)
+
+// Tokens are validated on every authenticated request. Deleted tokens are evicted
+// immediately in the process that deleted them and after the TTL in all other processes.
+const cache = createCache({
+	max: 1000,
+	ttl: cacheTtl
+})
 
 const add = async () => {
 
@@ -11,24 +22,40 @@ const add = async () => {
 
 const get = async (id) => {
 
-	return Token.findOne({
+	const cachedEntry = cache.get(id)
+
+	if (cachedEntry != null) return cachedEntry
+
+	const entry = await Token.findOne({
 		id
 	})
 
+	if (entry != null) cache.set(id, entry)
+
+	return entry
+
 }
 
 const update = async (id) => {
 
-	return runUpdate(Token, id)
+	const entry = await runUpdate(Token, id)
+
+	if (entry != null) cache.set(id, entry)
+
+	return entry
 
 }
 
 const del = async (id) => {
 
-	return Token.findOneAndDelete({
+	const entry = await Token.findOneAndDelete({
 		id
 	})
 
+	cache.del(id)
+
+	return entry
+
 }
 
 module.exports = {
@@ -36,4 +63,4 @@ module.exports = {
 	get,
 	update,
 	del
-}
\ No newline at end of file
+}
@@ -1,52 +1,205 @@
 'use strict'
 
 const Record = require('../schemas/Record')
+const View = require('../schemas/View')
+const aggregateViewRollups = require('../aggregations/aggregateViewRollups')
+const aggregateUniqueViews = require('../aggregations/aggregateUniqueViews')
 const aggregateDailyViews = require('../aggregations/aggregateDailyViews')
 const aggregateMonthlyViews = require('../aggregations/aggregateMonthlyViews')
 const aggregateYearlyViews = require('../aggregations/aggregateYearlyViews')
+const aggregateViewsOfDomains = require('../aggregations/aggregateViewsOfDomains')
+const aggregateUniqueViewsOfDomains = require('../aggregations/aggregateUniqueViewsOfDomains')
 const constants = require('../constants/views')
+const dayKey = require('../utils/dayKey')
+const intervalStart = require('../utils/intervalStart')
+const hyperLogLog = require('../utils/hyperLogLog')
+const analytics = require('../utils/analytics')
 
-const getUnique = async (id, interval) => {
+// Counts a view and adds the hashed visitor to the registers of the day
+const add = async (id, created, clientId) => {
+
+	const { index, rank } = hyperLogLog.register(clientId)
+
+	return View.updateOne({
+		domainId: id,
+		day: dayKey(created)
+	}, {
+		$inc: {
+			total: 1
+		},
+		$max: {
+			[`hll.${ index }`]: rank
+		}
+	}, {
+		upsert: true
+	})
+
+}
+
+const updateRegisters = async (registers) => {
+
+	return View.bulkWrite([ ...registers.values() ].map((entry) => ({
+		updateOne: {
+			filter: {
+				domainId: entry.domainId,
+				day: entry.day
+			},
+			update: {
+				$max: entry.hll
+			}
+		}
+	})), {
+		ordered: false
+	})
+
+}
+
+// Only the latest record of a visitor keeps its clientId, which is enough to count all visitors
+const rollupRegisters = async (filter) => {
+
+	const cursor = Record.find({
+		...filter,
+		clientId: {
+			$exists: true
+		}
+	}, {
+		domainId: 1,
+		created: 1,
+		day: 1,
+		clientId: 1
+	}).lean().batchSize(1000).cursor()
+
+	let registers = new Map()
+
+	for (let record = await cursor.next(); record != null; record = await cursor.next()) {
+
+		const day = record.day == null ? dayKey(record.created) : record.day
+		const key = `${ record.domainId }:${ day }`
+		const entry = registers.get(key) || { domainId: record.domainId, day, hll: {} }
+		const { index, rank } = hyperLogLog.register(record.clientId)
+
+		entry.hll[`hll.${ index }`] = Math.max(entry.hll[`hll.${ index }`] || 0, rank)
+		registers.set(key, entry)
+
+		if (registers.size >= 1000) {
+			await updateRegisters(registers)
+			registers = new Map()
+		}
 
-	switch (interval) {
-		case constants.VIEWS_INTERVAL_DAILY: return Record.aggregate(
-			aggregateDailyViews(id, true)
-		)
-		case constants.VIEWS_INTERVAL_MONTHLY: return Record.aggregate(
-			aggregateMonthlyViews(id, true)
-		)
-		case constants.VIEWS_INTERVAL_YEARLY: return Record.aggregate(
-			aggregateYearlyViews(id, true)
-		)
 	}
 
+	if (registers.size > 0) await updateRegisters(registers)
+
+}
+
+// Builds the rollups of all matching records. Existing rollups are either replaced
+// or kept when they already include the records.
+const rollup = async (filter, replace) => {
+
+	const entries = await Record.aggregate([
+		{
+			$match: filter
+		},
+		...aggregateViewRollups()
+	]).allowDiskUse(true)
+
+	// No need to continue when there're no entries
+	if (entries.length === 0) return 0
+
+	await View.bulkWrite(entries.map(({ domainId, day, ...data }) => (replace === true ? {
+		replaceOne: {
+			filter: { domainId, day },
+			replacement: { domainId, day, ...data },
+			upsert: true
+		}
+	} : {
+		updateOne: {
+			filter: { domainId, day },
+			update: { $setOnInsert: data },
+			upsert: true
+		}
+	})), {
+		ordered: false
+	})
+
+	await rollupRegisters(filter)
+
+	return entries.length
+
 }
 
-const getTotal = async (id, interval) => {
+const backfill = () => rollup({}, true)
+
+// Makes sure that the rollups include the matching records before they're removed
+const fold = (filter) => rollup(filter, false)
+
+const getUnique = async (id, interval, range) => {
+
+	const entries = await analytics.model(View).aggregate(
+		aggregateUniqueViews(id, interval, range)
+	)
+
+	return entries.map((entry) => ({
+		_id: entry._id,
+		count: hyperLogLog.estimate(entry.sum, entry.registers)
+	}))
+
+}
+
+const getTotal = async (id, interval, range) => {
 
 	switch (interval) {
-		case constants.VIEWS_INTERVAL_DAILY: return Record.aggregate(
-			aggregateDailyViews(id, false)
+		case constants.VIEWS_INTERVAL_DAILY: return analytics.model(View).aggregate(
+			aggregateDailyViews(id, range)
 		)
-		case constants.VIEWS_INTERVAL_MONTHLY: return Record.aggregate(
-			aggregateMonthlyViews(id, false)
+		case constants.VIEWS_INTERVAL_MONTHLY: return analytics.model(View).aggregate(
+			aggregateMonthlyViews(id, range)
 		)
-		case constants.VIEWS_INTERVAL_YEARLY: return Record.aggregate(
-			aggregateYearlyViews(id, false)
+		case constants.VIEWS_INTERVAL_YEARLY: return analytics.model(View).aggregate(
+			aggregateYearlyViews(id, range)
 		)
 	}
 
 }
 
-const get = async (id, type, interval) => {
+// Returns the latest periods or all periods of an optional custom range
+const get = async (id, type, interval, range) => {
 
 	switch (type) {
-		case constants.VIEWS_TYPE_UNIQUE: return getUnique(id, interval)
-		case constants.VIEWS_TYPE_TOTAL: return getTotal(id, interval)
+		case constants.VIEWS_TYPE_UNIQUE: return getUnique(id, interval, range)
+		case constants.VIEWS_TYPE_TOTAL: return getTotal(id, interval, range)
 	}
 
 }
 
+// Reads the views of multiple domains with one aggregation instead of one per domain. Uses the
+// latest 14 days, months or years without a custom range. Returns the entries of each domain.
+const getMultiple = async (ids, type, interval, range = { from: intervalStart(interval, 14), to: dayKey() }) => {
+
+	const entries = type === constants.VIEWS_TYPE_UNIQUE ? (await analytics.model(View).aggregate(
+		aggregateUniqueViewsOfDomains(ids, interval, range)
+	)).map((entry) => ({
+		_id: entry._id,
+		count: hyperLogLog.estimate(entry.sum, entry.registers)
+	})) : await analytics.model(View).aggregate(
+		aggregateViewsOfDomains(ids, interval, range)
+	)
+
+	const values = new Map(ids.map((id) => [ id, [] ]))
+
+	entries.forEach((entry) => values.get(entry._id.domainId).push({
+		_id: entry._id.period,
+		count: entry.count
+	}))
+
+	return ids.map((id) => values.get(id))
+
+}
+
 module.exports = {
-	get
+	add,
+	get,
+	getMultiple,
+	backfill,
+	fold
 }
\ No newline at end of file
@@ -3,43 +3,221 @@
 
 require('dotenv').config()
 
+const cluster = require('cluster')
 const mongoose = require('mongoose')
+const schedule = require('node-schedule')
 
 const server = require('./server')
+const Record = require('./schemas/Record')
+const View = require('./schemas/View')
+const Duration = require('./schemas/Duration')
+const records = require('./database/records')
+const sketches = require('./database/sketches')
+const retention = require('./database/retention')
 const signale = require('./utils/signale')
+const salt = require('./utils/salt')
+const connect = require('./utils/connect')
+const timeZone = require('./utils/timeZone')
+const dayKey = require('./utils/dayKey')
+const monitoring = require('./utils/monitoring')
+const analytics = require('./utils/analytics')
+const timeSeries = require('./utils/timeSeries')
 const isDemo = require('./utils/isDemo')
 const fillDatabase = require('./utils/fillDatabase')
 const stripUrlAuth = require('./utils/stripUrlAuth')
+const missingIndexes = require('./utils/missingIndexes')
 
 const port = process.env.ACKEE_PORT || process.env.PORT || 3000
 const dbUrl = process.env.ACKEE_MONGODB || process.env.MONGODB_URI
 const serverUrl = `http://localhost:${ port }`
+const workerCount = Number.parseInt(process.env.ACKEE_WORKERS) || 1
 
-mongoose.set('useFindAndModify', false)
+// The primary process runs the server itself or forks workers that share the port.
+// Jobs that must only run once are executed by the primary.
+const isPrimary = cluster.isMaster === true
+const isServer = workerCount === 1 || isPrimary === false
+
+let isShuttingDown = false
+
+// Maximum time to wait for pending requests when shutting down
+const closeTimeout = 5000
 
 server.on('listening', () => signale.watch(`Listening on ${ serverUrl }`))
 server.on('error', (err) => signale.fatal(err))
 
+const stopWorkers = () => Promise.all(Object.values(cluster.workers).map((worker) => new Promise((resolve) => {
+
+	if (worker.isDead() === true) return resolve()
+
+	worker.once('exit', resolve)
+	worker.process.kill('SIGTERM')
+
+})))
+
+// Resolves once all pending requests have been answered. Streams of live dashboards and
+// idle keep-alive connections would keep the server open, so it stops waiting after a timeout.
+const closeServer = () => new Promise((resolve) => {
+
+	const timer = setTimeout(resolve, closeTimeout)
+
+	server.close(() => {
+		clearTimeout(timer)
+		resolve()
+	})
+
+})
+
+// Stop accepting requests and write buffered records before exiting
+const shutdown = async () => {
+
+	// Signals can reach workers twice, from the terminal and from the primary
+	if (isShuttingDown === true) return
+	isShuttingDown = true
+
+	signale.await('Shutting down')
+
+	try {
+
+		if (isServer === true) {
+			// Pending requests might still add records to the buffers
+			await closeServer()
+			await records.flush()
+		}
+
+		if (isPrimary === true) await stopWorkers()
+
+		await mongoose.disconnect()
+
+		process.exit(0)
+
+	} catch (err) {
+
+		signale.fatal(err)
+		process.exit(1)
+
+	}
+
+}
+
+const startWorkers = () => {
+
+	signale.start(`Starting ${ workerCount } workers`)
+
+	for (let i = 0; i < workerCount; i++) cluster.fork()
+
+	// Replace workers that crashed
+	cluster.on('exit', (worker, code, signal) => {
+		if (isShuttingDown === true) return
+		signale.warn(`Worker ${ worker.process.pid } exited with ${ signal || code }, starting a new one`)
+		cluster.fork()
+	})
+
+}
+
+process.on('SIGTERM', shutdown)
+process.on('SIGINT', shutdown)
+
 if (dbUrl == null) {
 	signale.fatal('MongoDB connection URI missing in environment')
 	process.exit(1)
 }
 
-signale.await(`Connecting to ${ stripUrlAuth(dbUrl) }`)
+// Top values of removed records are only kept in their summaries
+if (retention.enabled === true && sketches.enabled === false) {
+	signale.fatal('`ACKEE_RETENTION_DAYS` requires `ACKEE_SKETCH_SIZE` to keep the top values of removed records')
+	process.exit(1)
+}
 
-mongoose.connect(dbUrl, {
+try {
+	dayKey(new Date())
+} catch (err) {
+	signale.fatal(`Unknown time zone \`${ timeZone }\` in \`ACKEE_TIMEZONE\``)
+	process.exit(1)
+}
 
-	useNewUrlParser: true,
-	useCreateIndex: true,
-	reconnectTries: Number.MAX_VALUE,
-	reconnectInterval: 1000
+signale.await(`Connecting to ${ stripUrlAuth(dbUrl) }`)
 
-}).then(() => {
+connect(dbUrl).then(async () => {
 
 	signale.success(`Connected to ${ stripUrlAuth(dbUrl) }`)
-	signale.start(`Starting the server`)
 
-	server.listen(port)
+	// Inserts would create regular collections, so the time-series collections must exist
+	// before the server and the workers start
+	if (isPrimary === true && timeSeries.enabled === true) {
+		await records.prepare()
+		signale.info('Records are stored in a time-series collection')
+	}
+
+	if (isServer === true) {
+
+		monitoring.watch(mongoose.connection.client)
+
+		// Aggregations of the dashboard may read from secondaries with their own pool
+		if (analytics.enabled === true) {
+			const connection = await analytics.connect(dbUrl)
+			monitoring.watch(connection.client)
+			signale.success('Connected for analytics')
+		}
+
+		// Workers must hash visitors with the salt of the primary
+		await salt.ready()
+
+		signale.start(`Starting the server`)
+		server.listen(port)
+
+	}
+
+	if (isPrimary === false) return
+	if (workerCount > 1) startWorkers()
+
+	// Indexes are built in the background. Warn when they aren't available afterwards
+	// (e.g. because autoIndex is disabled), as aggregations would scan all records.
+	Record.init()
+		.then(() => missingIndexes(Record))
+		.then((keys) => keys.forEach((key) => signale.warn(`Missing index ${ JSON.stringify(key) } on records`)))
+		.catch((err) => signale.warn(`Failed to verify indexes of records: ${ err.message }`))
+
+	// Summaries of top values of older versions don't include blocks of days
+	sketches.migrate()
+		.then((count) => count > 0 && signale.success(`Migrated ${ count } summaries of top values`))
+		.catch((err) => signale.warn(`Failed to migrate summaries of top values: ${ err.message }`))
+
+	// Views and durations are read from rollups. Installations with existing records need to build them once.
+	Promise.all([ View.estimatedDocumentCount(), Duration.estimatedDocumentCount(), Record.estimatedDocumentCount() ])
+		.then(([ viewCount, durationCount, recordCount ]) => {
+			if (viewCount === 0 && recordCount > 0) signale.warn('Views are empty. Run `yarn backfill` to build them from existing records')
+			if (durationCount === 0 && recordCount > 0) signale.warn('Durations are empty. Run `yarn backfill` to build them from existing records')
+		})
+		.catch((err) => signale.warn(`Failed to verify views: ${ err.message }`))
+
+	// Anonymizations that were pending when the previous process stopped can't be repeated, as the
+	// salt is new. Previous records are swept on start and after the daily salt changed, once the
+	// buffers of all processes have been written.
+	const sweep = () => records.sweep()
+		.then((count) => count > 0 && signale.info(`Anonymized ${ count } previous records`))
+		.catch((err) => signale.warn(`Failed to anonymize previous records: ${ err.message }`))
+
+	sweep()
+	schedule.scheduleJob({ rule: '10 0 * * *', tz: timeZone }, sweep)
+
+	// New top values are added to the summaries without truncating them
+	if (sketches.enabled === true) schedule.scheduleJob('* * * * *', () => {
+		sketches.compact()
+			.catch((err) => signale.warn(`Failed to compact summaries of top values: ${ err.message }`))
+	})
+
+	if (retention.enabled === true) {
+
+		// Remove old records every night. Runs on the primary only.
+		schedule.scheduleJob('0 3 * * *', () => {
+			retention.prune()
+				.then((count) => signale.info(`Removed ${ count } records older than ${ retention.days } days`))
+				.catch((err) => signale.fatal(err))
+		})
+
+		signale.info(`Records older than ${ retention.days } days will be removed daily`)
+
+	}
 
 	if (isDemo === true) {
 
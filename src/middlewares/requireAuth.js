@@ -4,10 +4,14 @@ const { createError } = require('micro')
 const { Bearer } = require('permit')
 
 const ttl = require('../utils/ttl')
+const { day } = require('../utils/times')
 const tokens = require('../database/tokens')
 
 const permit = new Bearer({ query: 'token' })
 
+const tokenTtl = Number.parseInt(process.env.ACKEE_TTL) || day
+const refreshRatio = process.env.ACKEE_TTL_REFRESH == null ? 0.01 : Number.parseFloat(process.env.ACKEE_TTL_REFRESH)
+
 module.exports = async (req, res) => {
 
 	const token = permit.check(req)
@@ -26,7 +30,7 @@ module.exports = async (req, res) => {
 		throw createError(400, 'Token invalid')
 	}
 
-	const valid = ttl(entry.updated, process.env.ACKEE_TTL)
+	const valid = ttl(entry.updated, tokenTtl)
 
 	// Token too old
 	if (valid === false) {
@@ -34,6 +38,9 @@ module.exports = async (req, res) => {
 		throw createError(400, 'Token invalid')
 	}
 
-	await tokens.update(token)
+	// Extending the lifetime on every request would cause a write per request. Only extend it
+	// when a noticeable part of the TTL passed since the last time.
+	const passed = Date.now() - entry.updated
+	if (passed > tokenTtl * refreshRatio) await tokens.update(token)
 
 }
\ No newline at end of file
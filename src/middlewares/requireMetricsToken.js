@@ -0,0 +1,28 @@
+'use strict'
+
+const crypto = require('crypto')
+const { createError } = require('micro')
+const { Bearer } = require('permit')
+
+const monitoring = require('../utils/monitoring')
+
+const permit = new Bearer({ query: 'token' })
+
+// Hashes have the same length, which is required to compare them in constant time
+const hash = (value) => crypto.createHash('sha256').update(value).digest()
+
+module.exports = async (req, res) => {
+
+	const token = permit.check(req)
+
+	if (token == null) {
+		permit.fail(res)
+		throw createError(400, 'Token missing')
+	}
+
+	if (crypto.timingSafeEqual(hash(token), hash(monitoring.token)) === false) {
+		permit.fail(res)
+		throw createError(400, 'Token invalid')
+	}
+
+}
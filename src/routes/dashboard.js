@@ -0,0 +1,120 @@
+'use strict'
+
+const { createError } = require('micro')
+
+const mapLimit = require('../utils/mapLimit')
+const domains = require('../database/domains')
+const durationsDatabase = require('../database/durations')
+const constants = require('../constants/metrics')
+const views = require('./views')
+const pages = require('./pages')
+const referrers = require('./referrers')
+const durations = require('./durations')
+const languages = require('./languages')
+const sizes = require('./sizes')
+const systems = require('./systems')
+const devices = require('./devices')
+const browsers = require('./browsers')
+
+const concurrency = Number.parseInt(process.env.ACKEE_DASHBOARD_CONCURRENCY) || 4
+
+const routes = {
+	[constants.METRICS_VIEWS]: views,
+	[constants.METRICS_PAGES]: pages,
+	[constants.METRICS_REFERRERS]: referrers,
+	[constants.METRICS_DURATIONS]: durations,
+	[constants.METRICS_LANGUAGES]: languages,
+	[constants.METRICS_SIZES]: sizes,
+	[constants.METRICS_SYSTEMS]: systems,
+	[constants.METRICS_DEVICES]: devices,
+	[constants.METRICS_BROWSERS]: browsers
+}
+
+const response = (entry) => ({
+	type: 'metric',
+	data: {
+		domainId: entry.domainId,
+		metric: entry.metric,
+		value: entry.value
+	}
+})
+
+const responses = (entries) => ({
+	type: 'dashboard',
+	data: entries.map(response)
+})
+
+// Parameters prefixed with the name of a metric (e.g. `pages.sorting`)
+// only apply to this metric and take precedence over shared parameters.
+const metricQuery = (query, metric) => {
+
+	const prefix = `${ metric }.`
+
+	return Object.keys(query).reduce((acc, key) => {
+
+		if (key.startsWith(prefix) === true) acc[key.substr(prefix.length)] = query[key]
+		else if (key.includes('.') === false && acc[key] == null) acc[key] = query[key]
+
+		return acc
+
+	}, {})
+
+}
+
+const get = async (req) => {
+
+	const { metrics, domainIds } = req.query
+
+	if (metrics == null) throw createError(400, 'Metrics missing')
+
+	const metricNames = metrics.split(',')
+
+	if (metricNames.every((metric) => constants.toArray().includes(metric)) === false) throw createError(400, 'Unknown metric')
+
+	const ids = domainIds == null ? (await domains.all()).map((domain) => domain.id) : domainIds.split(',')
+
+	const tasks = []
+
+	ids.forEach((domainId) => {
+		metricNames.forEach((metric) => tasks.push({ domainId, metric }))
+	})
+
+	// Views of all domains are read with one aggregation instead of one per domain
+	const multipleViews = metricNames.includes(constants.METRICS_VIEWS) === true ? await views.getMultiple(ids, metricQuery(req.query, constants.METRICS_VIEWS)) : []
+	const viewsByDomain = new Map(ids.map((domainId, index) => [ domainId, multipleViews[index] ]))
+
+	// Each metric is handled by its own route to share the validation and response format
+	const values = await mapLimit(tasks, concurrency, async ({ domainId, metric }) => {
+
+		if (metric === constants.METRICS_VIEWS) return viewsByDomain.get(domainId)
+
+		return routes[metric].get({
+			params: { domainId },
+			query: metricQuery(req.query, metric)
+		})
+
+	})
+
+	return responses(tasks.map((task, index) => ({
+		...task,
+		value: values[index]
+	})))
+
+}
+
+// Results depend on the versions of all included domains and their durations
+const dependencies = async (req) => {
+
+	const { metrics = '', domainIds } = req.query
+
+	const ids = domainIds == null ? (await domains.all()).map((domain) => domain.id) : domainIds.split(',')
+	const includesDurations = metrics.split(',').includes(constants.METRICS_DURATIONS)
+
+	return includesDurations === true ? [ ...ids, ...ids.map(durationsDatabase.version) ] : ids
+
+}
+
+module.exports = {
+	get,
+	dependencies
+}
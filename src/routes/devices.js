@@ -5,13 +5,16 @@ const { createError } = require('micro')
 const devices = require('../database/devices')
 const constants = require('../constants/devices')
 const ranges = require('../constants/ranges')
+const accuracies = require('../constants/accuracies')
+const parseRange = require('../utils/parseRange')
 
 const response = (entry) => ({
 	type: 'device',
 	data: {
 		id: entry._id,
 		count: entry.count,
-		created: entry.created
+		created: entry.created,
+		estimated: entry.estimated
 	}
 })
 
@@ -23,7 +26,7 @@ const responses = (entries) => ({
 const get = async (req) => {
 
 	const { domainId } = req.params
-	const { sorting, type, range = ranges.RANGES_LAST_7_DAYS } = req.query
+	const { sorting, type, range = ranges.RANGES_LAST_7_DAYS, accuracy = accuracies.ACCURACIES_EXACT, from, to } = req.query
 
 	const sortings = [
 		constants.DEVICES_SORTING_TOP,
@@ -38,8 +41,14 @@ const get = async (req) => {
 	if (sortings.includes(sorting) === false) throw createError(400, 'Unknown sorting')
 	if (types.includes(type) === false) throw createError(400, 'Unknown type')
 	if (ranges.toArray().includes(range) === false) throw createError(400, 'Unknown range')
+	if (accuracies.toArray().includes(accuracy) === false) throw createError(400, 'Unknown accuracy')
 
-	const entries = await devices.get(domainId, sorting, type, range)
+	// Custom ranges between `from` and `to` take precedence over the relative range
+	const customRange = parseRange(from, to)
+
+	if (customRange === null) throw createError(400, 'Invalid range')
+
+	const entries = await devices.get(domainId, sorting, type, customRange || range, accuracy)
 
 	return responses(entries)
 
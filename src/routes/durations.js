@@ -4,6 +4,7 @@ const { createError } = require('micro')
 
 const durations = require('../database/durations')
 const constants = require('../constants/durations')
+const parseRange = require('../utils/parseRange')
 
 const response = (entry) => ({
 	type: 'duration',
@@ -22,7 +23,7 @@ const responses = (entries) => ({
 const get = async (req) => {
 
 	const { domainId } = req.params
-	const { type } = req.query
+	const { type, from, to } = req.query
 
 	const types = [
 		constants.DURATIONS_TYPE_AVERAGE,
@@ -31,12 +32,21 @@ const get = async (req) => {
 
 	if (types.includes(type) === false) throw createError(400, 'Unknown type')
 
-	const entries = await durations.get(domainId, type)
+	// Returns the entries of a custom range when `from` or `to` are given
+	const range = parseRange(from, to)
+
+	if (range === null) throw createError(400, 'Invalid range')
+
+	const entries = await durations.get(domainId, type, range)
 
 	return responses(entries)
 
 }
 
+// Results change with every update of a record
+const dependencies = (req) => [ durations.version(req.params.domainId) ]
+
 module.exports = {
-	get
+	get,
+	dependencies
 }
\ No newline at end of file
@@ -5,13 +5,16 @@ const { createError } = require('micro')
 const languages = require('../database/languages')
 const constants = require('../constants/languages')
 const ranges = require('../constants/ranges')
+const accuracies = require('../constants/accuracies')
+const parseRange = require('../utils/parseRange')
 
 const response = (entry) => ({
 	type: 'language',
 	data: {
 		id: entry._id,
 		count: entry.count,
-		created: entry.created
+		created: entry.created,
+		estimated: entry.estimated
 	}
 })
 
@@ -23,7 +26,7 @@ const responses = (entries) => ({
 const get = async (req) => {
 
 	const { domainId } = req.params
-	const { sorting, range = ranges.RANGES_LAST_7_DAYS } = req.query
+	const { sorting, range = ranges.RANGES_LAST_7_DAYS, accuracy = accuracies.ACCURACIES_EXACT, from, to } = req.query
 
 	const sortings = [
 		constants.LANGUAGES_SORTING_TOP,
@@ -32,8 +35,14 @@ const get = async (req) => {
 
 	if (sortings.includes(sorting) === false) throw createError(400, 'Unknown sorting')
 	if (ranges.toArray().includes(range) === false) throw createError(400, 'Unknown range')
+	if (accuracies.toArray().includes(accuracy) === false) throw createError(400, 'Unknown accuracy')
 
-	const entries = await languages.get(domainId, sorting, range)
+	// Custom ranges between `from` and `to` take precedence over the relative range
+	const customRange = parseRange(from, to)
+
+	if (customRange === null) throw createError(400, 'Invalid range')
+
+	const entries = await languages.get(domainId, sorting, customRange || range, accuracy)
 
 	return responses(entries)
 
@@ -0,0 +1,47 @@
+'use strict'
+
+const live = require('../utils/live')
+const domains = require('../database/domains')
+
+// Comments keep proxies from closing idle connections
+const keepAliveInterval = 15000
+
+const event = (type, data) => `event: ${ type }\ndata: ${ JSON.stringify(data) }\n\n`
+
+// Streams the records of domains as Server-Sent Events while they're added. Dashboards
+// apply them to the results they already have instead of fetching them again.
+const get = async (req, res) => {
+
+	const { domainIds } = req.query
+
+	const ids = domainIds == null ? (await domains.all()).map((domain) => domain.id) : domainIds.split(',')
+
+	res.writeHead(200, {
+		'Content-Type': 'text/event-stream; charset=utf-8',
+		'Cache-Control': 'no-cache',
+		// Disables the response buffering of nginx
+		'X-Accel-Buffering': 'no'
+	})
+
+	res.write(event('ready', { domainIds: ids }))
+
+	const unsubscribe = live.subscribe(ids, (domainId, delta) => res.write(event('record', { domainId, ...delta })))
+	const timer = setInterval(() => res.write(':\n\n'), keepAliveInterval)
+
+	// The response stays open until the dashboard disconnects
+	return new Promise((resolve) => {
+
+		req.on('close', () => {
+			clearInterval(timer)
+			unsubscribe()
+			res.end()
+			resolve()
+		})
+
+	})
+
+}
+
+module.exports = {
+	get
+}
@@ -0,0 +1,24 @@
+'use strict'
+
+const records = require('../database/records')
+const monitoring = require('../utils/monitoring')
+
+monitoring.registry.gauge('ackee_buffer_entries', 'Entries waiting in the buffers of the process', () => {
+
+	const sizes = records.buffers()
+
+	return Object.keys(sizes).map((buffer) => ({ labels: { buffer }, value: sizes[buffer] }))
+
+})
+
+const get = async (req, res) => {
+
+	res.setHeader('Content-Type', 'text/plain; version=0.0.4; charset=utf-8')
+
+	return monitoring.render()
+
+}
+
+module.exports = {
+	get
+}
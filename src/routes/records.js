@@ -1,12 +1,21 @@
 'use strict'
 
+const zlib = require('zlib')
+const { pipeline, Transform } = require('stream')
 const { send, json, createError } = require('micro')
 
+const signale = require('../utils/signale')
 const normalizeUrl = require('../utils/normalizeUrl')
+const csvRow = require('../utils/csvRow')
+const isDefined = require('../utils/isDefined')
 const identifier = require('../utils/identifier')
 const messages = require('../utils/messages')
+const versions = require('../utils/versions')
+const live = require('../utils/live')
 const domains = require('../database/domains')
 const records = require('../database/records')
+const dictionary = require('../database/dictionary')
+const views = require('../database/views')
 
 const response = (entry) => ({
 	type: 'record',
@@ -32,6 +41,32 @@ const response = (entry) => ({
 	}
 })
 
+const exportFormats = {
+	ndjson: {
+		type: 'application/x-ndjson; charset=utf-8',
+		header: () => '',
+		line: (data) => `${ JSON.stringify(data) }\n`
+	},
+	csv: {
+		type: 'text/csv; charset=utf-8',
+		header: (fields) => csvRow(fields),
+		line: (data, fields) => csvRow(fields.map((field) => data[field]))
+	}
+}
+
+const parseDate = (value, name) => {
+
+	// The date is optional
+	if (value == null) return value
+
+	const date = new Date(/^\d+$/.test(value) === true ? Number.parseInt(value) : value)
+
+	if (Number.isNaN(date.getTime()) === true) throw createError(400, `Invalid \`${ name }\``)
+
+	return date
+
+}
+
 const normalizeSiteLocation = (siteLocation) => {
 
 	if (siteLocation == null) {
@@ -70,6 +105,47 @@ const normalizeSiteReferrer = (siteReferrer) => {
 
 }
 
+// Maximum number of entries of a batch
+const batchLimit = 100
+
+// Responds with the error of an entry. Other errors fail the whole batch.
+const errorResponse = (err) => {
+
+	if (err.name === 'ValidationError') return { type: 'error', data: { status: 400, message: messages(err.errors) } }
+	if (err.statusCode != null) return { type: 'error', data: { status: err.statusCode, message: err.message } }
+
+	throw err
+
+}
+
+// Values of a new record that change the results of the dashboard
+const delta = (entry) => {
+
+	const { id, domainId, ...data } = response(entry).data
+
+	return data
+
+}
+
+// Count the view and anonymize old entries of the user in the background
+const track = (entry, clientId) => {
+
+	// Cached results of the domain are outdated once the view has been counted
+	views.add(entry.domainId, entry.created, clientId)
+		.then(() => versions.bump(entry.domainId))
+		.catch((err) => signale.fatal(err))
+
+	// Values are read before buffered entries of the same user might get anonymized
+	const data = delta(entry)
+
+	// Anonymize old entries with the same clientId to prevent that the browsing history
+	// of a user is reconstructible. Users without previous entries are unique views of the day.
+	records.anonymize(clientId, entry.id)
+		.then((result) => live.publish(entry.domainId, { ...data, unique: result.nModified === 0 }))
+		.catch((err) => signale.fatal(err))
+
+}
+
 const add = async (req, res) => {
 
 	const { domainId } = req.params
@@ -99,9 +175,7 @@ const add = async (req, res) => {
 
 	}
 
-	// Anonymize old entries with the same clientId to prevent that the browsing history
-	// of a user is reconstructible. Will be skipped when there're no previous entries.
-	await records.anonymize(clientId, entry.id)
+	track(entry, clientId)
 
 	return send(res, 201, response(entry))
 
@@ -133,7 +207,136 @@ const update = async (req) => {
 
 }
 
+const prepareEntry = (req, entry, knownDomains) => {
+
+	if (entry == null || typeof entry !== 'object') throw createError(400, 'Invalid entry')
+
+	if (entry.action === 'update') {
+
+		if (typeof entry.recordId !== 'string') throw createError(400, 'Path `recordId` is required')
+
+		return { action: entry.action, recordId: entry.recordId }
+
+	}
+
+	if (entry.action !== 'add') throw createError(400, 'Unknown action')
+	if (knownDomains.get(entry.domainId) == null) throw createError(404, 'Unknown domain')
+
+	const clientId = identifier(req, entry.domainId)
+	const data = { ...entry.data, clientId, domainId: entry.domainId }
+
+	data.siteLocation = normalizeSiteLocation(data.siteLocation)
+	data.siteReferrer = normalizeSiteReferrer(data.siteReferrer)
+
+	return { action: entry.action, clientId, data }
+
+}
+
+// Adds and updates records of multiple domains with one request and one write. The body can be
+// sent as `text/plain` with `navigator.sendBeacon`, which doesn't require a preflight request.
+const batch = async (req) => {
+
+	// micro parses the body regardless of its content type
+	const entries = await json(req)
+
+	if (Array.isArray(entries) === false) throw createError(400, 'Batch must be an array')
+	if (entries.length > batchLimit) throw createError(400, `Batch must not contain more than ${ batchLimit } entries`)
+
+	const domainIds = [ ...new Set(entries.filter((entry) => entry != null && typeof entry.domainId === 'string').map((entry) => entry.domainId)) ]
+	const knownDomains = new Map(await Promise.all(domainIds.map(async (domainId) => [ domainId, await domains.get(domainId) ])))
+
+	// All entries are validated before anything is written. Invalid entries only fail themselves.
+	const preparedEntries = entries.map((entry) => {
+		try {
+			return prepareEntry(req, entry, knownDomains)
+		} catch (err) {
+			return err
+		}
+	})
+
+	const validEntries = preparedEntries.filter((entry) => entry instanceof Error === false)
+	const additions = validEntries.filter((entry) => entry.action === 'add')
+	const updates = validEntries.filter((entry) => entry.action === 'update')
+
+	const result = await records.batch(additions.map((entry) => entry.data), updates.map((entry) => entry.recordId))
+
+	additions.forEach((entry, index) => {
+		entry.result = result.created[index]
+		if (entry.result instanceof Error === false) track(entry.result, entry.clientId)
+	})
+
+	updates.forEach((entry, index) => {
+		entry.result = result.updated[index] == null ? createError(404, 'Unknown record') : result.updated[index]
+	})
+
+	return {
+		type: 'batch',
+		data: preparedEntries.map((entry) => {
+			const value = entry instanceof Error ? entry : entry.result
+			return value instanceof Error ? errorResponse(value) : response(value)
+		})
+	}
+
+}
+
+// Streams all records of a range. The cursor is only read as fast as the client receives the data.
+const exportRecords = async (req, res) => {
+
+	const { domainId } = req.params
+	const { format = 'ndjson', compression } = req.query
+
+	const exportFormat = exportFormats[format]
+
+	if (exportFormat == null) throw createError(400, 'Unknown format')
+	if (compression != null && compression !== 'gzip') throw createError(400, 'Unknown compression')
+
+	const from = parseDate(req.query.from, 'from')
+	const to = parseDate(req.query.to, 'to')
+
+	const domain = await domains.get(domainId)
+
+	if (domain == null) throw createError(404, 'Unknown domain')
+
+	const fields = Object.keys(response({}).data)
+
+	const serialize = new Transform({
+		writableObjectMode: true,
+		// Records contain the ids of dimensions when they have been encoded
+		transform: (entry, encoding, callback) => {
+			dictionary.decodeRecord(entry)
+				.then((decodedEntry) => callback(null, exportFormat.line(response(decodedEntry).data, fields)))
+				.catch(callback)
+		}
+	})
+
+	serialize.push(exportFormat.header(fields))
+
+	res.setHeader('Content-Type', exportFormat.type)
+	res.setHeader('Content-Disposition', `attachment; filename="${ domainId }.${ format }"`)
+	if (compression === 'gzip') res.setHeader('Content-Encoding', 'gzip')
+
+	const streams = [
+		records.stream(domainId, from, to),
+		serialize,
+		compression === 'gzip' ? zlib.createGzip() : undefined,
+		res
+	].filter(isDefined)
+
+	return new Promise((resolve) => {
+
+		pipeline(...streams, (err) => {
+			// The response has already been started and can't contain the error anymore
+			if (err != null) signale.warn(`Failed to export records: ${ err.message }`)
+			resolve()
+		})
+
+	})
+
+}
+
 module.exports = {
 	add,
-	update
+	update,
+	batch,
+	export: exportRecords
 }
\ No newline at end of file
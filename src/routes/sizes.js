@@ -5,13 +5,16 @@ const { createError } = require('micro')
 const sizes = require('../database/sizes')
 const constants = require('../constants/sizes')
 const ranges = require('../constants/ranges')
+const accuracies = require('../constants/accuracies')
+const parseRange = require('../utils/parseRange')
 
 const response = (entry) => ({
 	type: 'size',
 	data: {
 		id: entry._id,
 		count: entry.count,
-		created: entry.created
+		created: entry.created,
+		estimated: entry.estimated
 	}
 })
 
@@ -23,7 +26,7 @@ const responses = (entries) => ({
 const get = async (req) => {
 
 	const { domainId } = req.params
-	const { type, range = ranges.RANGES_LAST_7_DAYS } = req.query
+	const { type, range = ranges.RANGES_LAST_7_DAYS, accuracy = accuracies.ACCURACIES_EXACT, from, to } = req.query
 
 	const types = [
 		constants.SIZES_TYPE_BROWSER_HEIGHT,
@@ -36,8 +39,14 @@ const get = async (req) => {
 
 	if (types.includes(type) === false) throw createError(400, 'Unknown type')
 	if (ranges.toArray().includes(range) === false) throw createError(400, 'Unknown range')
+	if (accuracies.toArray().includes(accuracy) === false) throw createError(400, 'Unknown accuracy')
 
-	const entries = await sizes.get(domainId, type, range)
+	// Custom ranges between `from` and `to` take precedence over the relative range
+	const customRange = parseRange(from, to)
+
+	if (customRange === null) throw createError(400, 'Invalid range')
+
+	const entries = await sizes.get(domainId, type, customRange || range, accuracy)
 
 	return responses(entries)
 
@@ -1,115 +1,124 @@
 'use strict'
 
 const { resolve } = require('path')
-const { readFile } = require('fs').promises
-const sass = require('rosid-handler-sass')
-const js = require('rosid-handler-js')
+const { readFileSync } = require('fs')
 
-const html = require('../ui/index')
+const assets = require('../ui/assets')
 
-const isDemo = require('../utils/isDemo')
+const signale = require('../utils/signale')
+const createAsset = require('../utils/createAsset')
+const sendAsset = require('../utils/sendAsset')
 const isProductionEnv = require('../utils/isProductionEnv')
+const { hour, day } = require('../utils/times')
 
-const index = () => {
+const distPath = resolve(__dirname, '../../dist')
 
-	const data = html()
+const CACHE_REVALIDATE = 'no-cache'
+const CACHE_IMMUTABLE = 'public, max-age=31536000, immutable'
+const CACHE_FAVICON = `public, max-age=${ day / 1000 }`
 
-	return async (req, res) => {
+// The tracker is requested by every visitor of every site. Proxies and CDNs may keep it longer
+// than browsers, which revalidate it with its ETag.
+const CACHE_TRACKER = `public, max-age=${ hour / 1000 }, s-maxage=${ day / 1000 }, stale-while-revalidate=${ day / 1000 }`
 
-		res.setHeader('Content-Type', 'text/html; charset=utf-8')
-		res.end(await data)
+// Loads the assets of `yarn build`. Scripts contain the environment, so prebuilt
+// assets are only used when they have been built with the current one.
+const loadPrebuiltAssets = () => {
 
+	let manifest
+
+	try {
+		manifest = JSON.parse(readFileSync(resolve(distPath, 'manifest.json'), 'utf8'))
+	} catch (err) {
+		return
 	}
 
-}
+	if (JSON.stringify(manifest.env) !== JSON.stringify(assets.env(true))) {
+		signale.warn('Prebuilt assets have been built with a different environment. Run `yarn build` again to use them')
+		return
+	}
 
-const favicon = () => {
+	const readOptional = (filePath) => {
+		try {
+			return readFileSync(filePath)
+		} catch (err) {
+			return undefined
+		}
+	}
 
-	const filePath = resolve(__dirname, '../ui/images/favicon.ico')
-	const data = readFile(filePath)
+	return Object.keys(manifest.assets).reduce((acc, name) => {
 
-	return async (req, res) => {
+		const { file, type } = manifest.assets[name]
 
-		res.setHeader('Content-Type', 'image/vnd.microsoft.icon')
-		res.end(await data)
+		acc[name] = createAsset({
+			content: readFileSync(resolve(distPath, file)),
+			type,
+			gzip: readFileSync(resolve(distPath, `${ file }.gz`)),
+			brotli: readOptional(resolve(distPath, `${ file }.br`))
+		})
 
-	}
+		return acc
+
+	}, {})
 
 }
 
-const styles = () => {
+const prebuiltAssets = isProductionEnv === true ? loadPrebuiltAssets() : undefined
+const compiledAssets = new Map()
+
+const compileAsset = async (name) => {
 
-	const filePath = resolve(__dirname, '../ui/styles/index.scss')
-	const data = sass(filePath, { optimize: isProductionEnv === true })
+	if (name === 'index.html') {
 
-	return async (req, res) => {
+		const [ styles, scripts ] = await Promise.all([ getAsset('index.css'), getAsset('index.js') ])
 
-		res.setHeader('Content-Type', 'text/css; charset=utf-8')
-		res.end(await data)
+		return createAsset({ content: assets.html(styles, scripts), type: assets.htmlType })
 
 	}
 
-}
+	const { type, compile } = assets.files[name]
 
-const scripts = () => {
-
-	const filePath = resolve(__dirname, '../ui/scripts/index.js')
-
-	const babel = {
-		presets: [
-			[
-				'@babel/preset-env', {
-					targets: {
-						browsers: [
-							'last 2 Safari versions',
-							'last 2 Chrome versions',
-							'last 2 Opera versions',
-							'last 2 Firefox versions'
-						]
-					}
-				}
-			]
-		],
-		babelrc: false
-	}
+	return createAsset({ content: await compile(isProductionEnv), type })
 
-	const data = js(filePath, {
-		optimize: isProductionEnv === true,
-		env: {
-			ACKEE_TRACKER: process.env.ACKEE_TRACKER,
-			ACKEE_DEMO: isDemo === true ? 'true' : 'false',
-			NODE_ENV: isProductionEnv === true ? 'production' : 'development'
-		},
-		babel
-	})
+}
 
-	return async (req, res) => {
+// Assets are compiled once in production and on every request in development
+const getAsset = (name) => {
 
-		res.setHeader('Content-Type', 'application/javascript; charset=utf-8')
-		res.end(await data)
+	if (prebuiltAssets != null) return Promise.resolve(prebuiltAssets[name])
+	if (isProductionEnv === false) return compileAsset(name)
 
-	}
+	if (compiledAssets.has(name) === false) compiledAssets.set(name, compileAsset(name))
+
+	return compiledAssets.get(name)
 
 }
 
-const tracker = () => {
+const send = (name, cacheControl) => async (req, res) => {
 
-	const filePath = require.resolve('ackee-tracker')
-	const data = readFile(filePath, 'utf8')
+	sendAsset(req, res, await getAsset(name), cacheControl)
 
-	return async (req, res) => {
+}
 
-		res.setHeader('Content-Type', 'text/javascript; charset=utf-8')
-		res.end(await data)
+// Hashed URLs never change their content. Outdated hashes still receive the current asset, but it can't be cached forever.
+const sendHashed = (name) => async (req, res) => {
 
-	}
+	const asset = await getAsset(name)
+	const isCurrent = req.params != null && req.params.hash === asset.hash
 
+	sendAsset(req, res, asset, isCurrent === true ? CACHE_IMMUTABLE : CACHE_REVALIDATE)
+
+}
+
+// Compile all assets when starting the server instead of with the first request
+if (isProductionEnv === true && prebuiltAssets == null) {
+	[ ...Object.keys(assets.files), 'index.html' ].forEach((name) => getAsset(name).catch((err) => signale.fatal(err)))
 }
 
 module.exports = {
-	index: isProductionEnv === true ? index() : (req, res) => index()(req, res),
-	favicon: isProductionEnv === true ? favicon() : (req, res) => favicon()(req, res),
-	styles: isProductionEnv === true ? styles() : (req, res) => styles()(req, res),
-	scripts: isProductionEnv === true ? scripts() : (req, res) => scripts()(req, res),
-	tracker: isProductionEnv === true ? tracker() : (req, res) => tracker()(req, res)
-}
\ No newline at end of file
+	index: send('index.html', CACHE_REVALIDATE),
+	favicon: send('favicon.ico', CACHE_FAVICON),
+	styles: sendHashed('index.css'),
+	scripts: sendHashed('index.js'),
+	tracker: send('tracker.js', CACHE_TRACKER)
+}
@@ -4,6 +4,7 @@ const { createError } = require('micro')
 
 const views = require('../database/views')
 const constants = require('../constants/views')
+const parseRange = require('../utils/parseRange')
 
 const response = (entry) => ({
 	type: 'view',
@@ -22,10 +23,10 @@ const responses = (entries) => ({
 	data: entries.map(response)
 })
 
-const get = async (req) => {
+// Validates the parameters shared by a single and multiple domains
+const parseQuery = (query) => {
 
-	const { domainId } = req.params
-	const { type, interval } = req.query
+	const { type, interval, from, to } = query
 
 	const types = [
 		constants.VIEWS_TYPE_UNIQUE,
@@ -41,12 +42,38 @@ const get = async (req) => {
 	if (types.includes(type) === false) throw createError(400, 'Unknown type')
 	if (intervals.includes(interval) === false) throw createError(400, 'Unknown interval')
 
-	const entries = await views.get(domainId, type, interval)
+	// Returns the entries of a custom range when `from` or `to` are given
+	const range = parseRange(from, to)
+
+	if (range === null) throw createError(400, 'Invalid range')
+
+	return { type, interval, range }
+
+}
+
+const get = async (req) => {
+
+	const { domainId } = req.params
+	const { type, interval, range } = parseQuery(req.query)
+
+	const entries = await views.get(domainId, type, interval, range)
 
 	return responses(entries)
 
 }
 
+// Returns the response of each domain with one aggregation for all of them
+const getMultiple = async (ids, query) => {
+
+	const { type, interval, range } = parseQuery(query)
+
+	const values = await views.getMultiple(ids, type, interval, range)
+
+	return values.map(responses)
+
+}
+
 module.exports = {
-	get
+	get,
+	getMultiple
 }
\ No newline at end of file
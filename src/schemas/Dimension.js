@@ -0,0 +1,36 @@
+'use strict'
+
+const mongoose = require('mongoose')
+
+// Value of a property of records that's stored as a small integer on the records.
+// Ids are counted per property.
+const schema = new mongoose.Schema({
+	property: {
+		type: String,
+		required: true
+	},
+	value: {
+		type: String,
+		required: true
+	},
+	id: {
+		type: Number,
+		required: true
+	}
+})
+
+schema.index({
+	property: 1,
+	value: 1
+}, {
+	unique: true
+})
+
+schema.index({
+	property: 1,
+	id: -1
+}, {
+	unique: true
+})
+
+module.exports = mongoose.model('Dimension', schema)
@@ -0,0 +1,33 @@
+'use strict'
+
+const mongoose = require('mongoose')
+
+// Daily histogram of the durations of a domain. Each bucket counts the records
+// with a duration in the bucket's interval. Updated when records are added or
+// updated so durations can be aggregated without touching the records.
+const schema = new mongoose.Schema({
+	domainId: {
+		type: String,
+		required: true
+	},
+	day: {
+		type: Number,
+		required: true
+	},
+	buckets: {
+		type: Object,
+		required: true,
+		default: {}
+	}
+}, {
+	minimize: false
+})
+
+schema.index({
+	domainId: 1,
+	day: -1
+}, {
+	unique: true
+})
+
+module.exports = mongoose.model('Duration', schema)
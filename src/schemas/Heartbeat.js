@@ -0,0 +1,36 @@
+'use strict'
+
+const mongoose = require('mongoose')
+
+// Update of a record that is stored in a time-series collection, which can't be updated
+// efficiently. The duration of the record ends with its latest heartbeat.
+const schema = new mongoose.Schema({
+	recordId: {
+		type: String,
+		required: true
+	},
+	domainId: {
+		type: String,
+		required: true
+	},
+	created: {
+		type: Date,
+		required: true
+	},
+	updated: {
+		type: Date,
+		required: true,
+		default: Date.now
+	}
+}, {
+	// Indexes are built once the time-series collection has been created
+	autoIndex: false,
+	versionKey: false
+})
+
+schema.index({
+	recordId: 1,
+	updated: -1
+})
+
+module.exports = mongoose.model('Heartbeat', schema)
\ No newline at end of file
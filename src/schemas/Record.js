@@ -4,13 +4,18 @@ const mongoose = require('mongoose')
 const uuid = require('uuid').v4
 const isUrl = require('is-url')
 
+const dayKey = require('../utils/dayKey')
+const timeSeries = require('../utils/timeSeries')
+
 const isNullOrUrl = (value) => value == null || isUrl(value)
 
 const schema = new mongoose.Schema({
 	id: {
 		type: String,
 		required: true,
-		unique: true,
+		// Time-series collections don't support unique indexes
+		unique: timeSeries.enabled === false,
+		index: timeSeries.enabled === true,
 		default: uuid
 	},
 	clientId: {
@@ -86,7 +91,69 @@ const schema = new mongoose.Schema({
 		type: Date,
 		required: true,
 		default: Date.now
+	},
+	// Day (yyyymmdd) of the creation in the reporting time zone,
+	// so rollups don't need to calculate it from `created`
+	day: {
+		type: Number,
+		default: function() {
+			return dayKey(this.created)
+		}
 	}
+}, {
+	// Indexes of time-series collections are built once the collection has been created
+	autoIndex: timeSeries.enabled === false
+})
+
+// Properties that are grouped or sorted by the top, new and recent aggregations.
+// Each one gets a partial index so records without the property don't bloat it.
+const fieldIndexes = [
+	'siteLocation',
+	'siteReferrer',
+	'siteLanguage',
+	'screenWidth',
+	'screenHeight',
+	'deviceManufacturer',
+	'osName',
+	'browserName',
+	'browserWidth',
+	'browserHeight'
+]
+
+schema.index({
+	domainId: 1,
+	created: -1
+})
+
+// Approximate results only read the records of a range of ids
+schema.index({
+	domainId: 1,
+	id: 1
+})
+
+// Anonymized records don't have a clientId and are excluded
+schema.index({
+	clientId: 1
+}, {
+	partialFilterExpression: {
+		clientId: {
+			$exists: true
+		}
+	}
+})
+
+fieldIndexes.forEach((property) => {
+	schema.index({
+		domainId: 1,
+		created: -1,
+		[property]: 1
+	}, {
+		partialFilterExpression: {
+			[property]: {
+				$exists: true
+			}
+		}
+	})
 })
 
 module.exports = mongoose.model('Record', schema)
\ No newline at end of file
@@ -0,0 +1,77 @@
+'use strict'
+
+const mongoose = require('mongoose')
+
+// Space-Saving summary of the most frequent values of a dimension for a day or a block of
+// days. Blocks of level n contain 2^n days starting at `day` (see utils/dyadicBlocks).
+// A dimension is one or more properties of records joined by a comma.
+// New values are added to `pending` and merged into the counters by the primary, which keeps
+// the summary at its size. The version is used to merge them without losing concurrent updates.
+// `hasPending` marks the summaries that need to be merged.
+const schema = new mongoose.Schema({
+	domainId: {
+		type: String,
+		required: true
+	},
+	day: {
+		type: Number,
+		required: true
+	},
+	level: {
+		type: Number,
+		required: true,
+		default: 0
+	},
+	dimension: {
+		type: String,
+		required: true
+	},
+	counters: [
+		{
+			_id: false,
+			value: mongoose.Schema.Types.Mixed,
+			count: Number,
+			error: Number
+		}
+	],
+	pending: [
+		{
+			_id: false,
+			value: mongoose.Schema.Types.Mixed,
+			count: Number
+		}
+	],
+	pendingCount: {
+		type: Number,
+		default: 0
+	},
+	hasPending: {
+		type: Boolean,
+		default: false
+	},
+	version: {
+		type: Number,
+		required: true,
+		default: 0
+	}
+})
+
+schema.index({
+	domainId: 1,
+	dimension: 1,
+	level: 1,
+	day: -1
+}, {
+	unique: true
+})
+
+schema.index({
+	hasPending: 1,
+	pendingCount: 1
+}, {
+	partialFilterExpression: {
+		hasPending: true
+	}
+})
+
+module.exports = mongoose.model('Sketch', schema)
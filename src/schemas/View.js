@@ -0,0 +1,38 @@
+'use strict'
+
+const mongoose = require('mongoose')
+
+// Daily rollup of the records of a domain. Updated on every new record so
+// views can be aggregated without touching the records. Unique views are
+// counted with the sparse HyperLogLog registers of utils/hyperLogLog.
+const schema = new mongoose.Schema({
+	domainId: {
+		type: String,
+		required: true
+	},
+	day: {
+		type: Number,
+		required: true
+	},
+	total: {
+		type: Number,
+		required: true,
+		default: 0
+	},
+	hll: {
+		type: Object,
+		required: true,
+		default: {}
+	}
+}, {
+	minimize: false
+})
+
+schema.index({
+	domainId: 1,
+	day: -1
+}, {
+	unique: true
+})
+
+module.exports = mongoose.model('View', schema)
@@ -2,14 +2,17 @@
 
 const micro = require('micro')
 const { send, createError } = require('micro')
-const { router, get, post, put, patch, del } = require('microrouter')
+const microrouter = require('microrouter')
 
 const signale = require('./utils/signale')
 const pipe = require('./utils/pipe')
+const conditional = require('./utils/conditional')
 const isDefined = require('./utils/isDefined')
 const customTrackerUrl = require('./utils/customTrackerUrl')
+const monitoring = require('./utils/monitoring')
 const requireAuth = require('./middlewares/requireAuth')
 const blockDemo = require('./middlewares/blockDemo')
+const requireMetricsToken = require('./middlewares/requireMetricsToken')
 const ui = require('./routes/ui')
 const tokens = require('./routes/tokens')
 const domains = require('./routes/domains')
@@ -23,6 +26,16 @@ const sizes = require('./routes/sizes')
 const systems = require('./routes/systems')
 const devices = require('./routes/devices')
 const browsers = require('./routes/browsers')
+const dashboard = require('./routes/dashboard')
+const live = require('./routes/live')
+const metrics = require('./routes/monitoring')
+
+const { router } = microrouter
+
+// Routes are measured by their path when the metrics endpoint is enabled
+const [ get, post, put, patch, del ] = [ 'get', 'post', 'put', 'patch', 'del' ].map((method) => {
+	return (path, fn) => microrouter[method](path, monitoring.observe(path, fn))
+})
 
 const catchError = (fn) => async (req, res) => {
 
@@ -85,7 +98,9 @@ const routes = [
 	get('/index.html', ui.index),
 	get('/favicon.ico', ui.favicon),
 	get('/index.css', ui.styles),
+	get('/index.:hash.css', ui.styles),
 	get('/index.js', ui.scripts),
+	get('/index.:hash.js', ui.scripts),
 	get('/tracker.js', ui.tracker),
 	customTrackerUrl != null ? get(customTrackerUrl, ui.tracker) : undefined,
 
@@ -97,26 +112,33 @@ const routes = [
 	put('/domains/:domainId', pipe(requireAuth, blockDemo, domains.update)),
 	del('/domains/:domainId', pipe(requireAuth, blockDemo, domains.del)),
 
+	post('/records/batch', records.batch),
 	post('/domains/:domainId/records', records.add),
 	patch('/domains/:domainId/records/:recordId', records.update),
+	get('/domains/:domainId/records/export', pipe(requireAuth, records.export)),
+
+	get('/domains/:domainId/views', pipe(requireAuth, conditional(views.get))),
+
+	get('/domains/:domainId/pages', pipe(requireAuth, conditional(pages.get))),
 
-	get('/domains/:domainId/views', pipe(requireAuth, views.get)),
+	get('/domains/:domainId/referrers', pipe(requireAuth, conditional(referrers.get))),
 
-	get('/domains/:domainId/pages', pipe(requireAuth, pages.get)),
+	get('/domains/:domainId/languages', pipe(requireAuth, conditional(languages.get))),
 
-	get('/domains/:domainId/referrers', pipe(requireAuth, referrers.get)),
+	get('/domains/:domainId/durations', pipe(requireAuth, conditional(durations.get, durations.dependencies))),
 
-	get('/domains/:domainId/languages', pipe(requireAuth, languages.get)),
+	get('/domains/:domainId/sizes', pipe(requireAuth, conditional(sizes.get))),
 
-	get('/domains/:domainId/durations', pipe(requireAuth, durations.get)),
+	get('/domains/:domainId/systems', pipe(requireAuth, conditional(systems.get))),
 
-	get('/domains/:domainId/sizes', pipe(requireAuth, sizes.get)),
+	get('/domains/:domainId/devices', pipe(requireAuth, conditional(devices.get))),
 
-	get('/domains/:domainId/systems', pipe(requireAuth, systems.get)),
+	get('/domains/:domainId/browsers', pipe(requireAuth, conditional(browsers.get))),
 
-	get('/domains/:domainId/devices', pipe(requireAuth, devices.get)),
+	get('/dashboard', pipe(requireAuth, conditional(dashboard.get, dashboard.dependencies))),
+	get('/dashboard/live', pipe(requireAuth, live.get)),
 
-	get('/domains/:domainId/browsers', pipe(requireAuth, browsers.get)),
+	monitoring.enabled === true ? get('/metrics', pipe(requireMetricsToken, metrics.get)) : undefined,
 
 	get('/*', notFound),
 	post('/*', notFound),
@@ -0,0 +1,104 @@
+'use strict'
+
+const { resolve } = require('path')
+const { readFile } = require('fs').promises
+
+const index = require('./index')
+const isDemo = require('../utils/isDemo')
+
+// Values that are included in the scripts while compiling them
+const env = (optimize) => ({
+	ACKEE_TRACKER: process.env.ACKEE_TRACKER,
+	ACKEE_DEMO: isDemo === true ? 'true' : 'false',
+	NODE_ENV: optimize === true ? 'production' : 'development'
+})
+
+const favicon = () => {
+
+	const filePath = resolve(__dirname, './images/favicon.ico')
+
+	return readFile(filePath)
+
+}
+
+// Compilers are loaded lazily as they aren't needed when serving prebuilt assets
+const styles = (optimize) => {
+
+	const sass = require('rosid-handler-sass')
+	const filePath = resolve(__dirname, './styles/index.scss')
+
+	return sass(filePath, { optimize })
+
+}
+
+const scripts = (optimize) => {
+
+	const js = require('rosid-handler-js')
+	const filePath = resolve(__dirname, './scripts/index.js')
+
+	const babel = {
+		presets: [
+			[
+				'@babel/preset-env', {
+					targets: {
+						browsers: [
+							'last 2 Safari versions',
+							'last 2 Chrome versions',
+							'last 2 Opera versions',
+							'last 2 Firefox versions'
+						]
+					}
+				}
+			]
+		],
+		babelrc: false
+	}
+
+	return js(filePath, {
+		optimize,
+		env: env(optimize),
+		babel
+	})
+
+}
+
+const tracker = () => {
+
+	const filePath = require.resolve('ackee-tracker')
+
+	return readFile(filePath, 'utf8')
+
+}
+
+// Links the hashed URLs of the compiled assets so they can be cached forever
+const html = (stylesAsset, scriptsAsset) => {
+
+	return index([ `index.${ stylesAsset.hash }.css` ], [ `index.${ scriptsAsset.hash }.js` ])
+
+}
+
+const files = {
+	'index.css': {
+		type: 'text/css; charset=utf-8',
+		compile: styles
+	},
+	'index.js': {
+		type: 'application/javascript; charset=utf-8',
+		compile: scripts
+	},
+	'tracker.js': {
+		type: 'text/javascript; charset=utf-8',
+		compile: tracker
+	},
+	'favicon.ico': {
+		type: 'image/vnd.microsoft.icon',
+		compile: favicon
+	}
+}
+
+module.exports = {
+	env,
+	html,
+	htmlType: 'text/html; charset=utf-8',
+	files
+}
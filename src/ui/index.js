@@ -2,8 +2,8 @@
 
 const layout = require('../utils/layout')
 
-module.exports = () => {
+module.exports = (styles = [ 'index.css' ], scripts = [ 'index.js' ]) => {
 
-	return layout('<div id="main"></div>', 'favicon.ico', [ 'index.css' ], [ 'index.js' ])
+	return layout('<div id="main"></div>', 'favicon.ico', styles, scripts)
 
-}
\ No newline at end of file
+}
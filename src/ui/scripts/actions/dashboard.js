@@ -0,0 +1,145 @@
+import api from '../utils/api'
+import signalHandler from '../utils/signalHandler'
+
+import * as metrics from '../../../constants/metrics'
+import * as ranges from '../../../constants/ranges'
+import * as accuracies from '../../../constants/accuracies'
+
+import { setViewsValue, setViewsFetching, setViewsError } from './views'
+import { setPagesValue, setPagesFetching, setPagesError } from './pages'
+import { setReferrersValue, setReferrersFetching, setReferrersError } from './referrers'
+import { setDurationsValue, setDurationsFetching, setDurationsError } from './durations'
+import { setLanguagesValue, setLanguagesFetching, setLanguagesError } from './languages'
+import { setSizesValue, setSizesFetching, setSizesError } from './sizes'
+import { setSystemsValue, setSystemsFetching, setSystemsError } from './systems'
+import { setDevicesValue, setDevicesFetching, setDevicesError } from './devices'
+import { setBrowsersValue, setBrowsersFetching, setBrowsersError } from './browsers'
+
+// Results of all records are estimated from a sample as they'd take long for large domains
+const accuracy = (props) => props.filter.range === ranges.RANGES_ALL_TIME ? accuracies.ACCURACIES_APPROXIMATE : accuracies.ACCURACIES_EXACT
+
+// Parameters and actions of each metric. The parameters equal the ones of the individual fetch actions.
+const handlers = {
+	[metrics.METRICS_VIEWS]: {
+		query: (props) => ({ type: props.views.type, interval: props.views.interval }),
+		setValue: setViewsValue,
+		setFetching: setViewsFetching,
+		setError: setViewsError
+	},
+	[metrics.METRICS_PAGES]: {
+		query: (props) => ({ sorting: props.pages.sorting, range: props.filter.range, accuracy: accuracy(props) }),
+		setValue: setPagesValue,
+		setFetching: setPagesFetching,
+		setError: setPagesError
+	},
+	[metrics.METRICS_REFERRERS]: {
+		query: (props) => ({ sorting: props.referrers.sorting, range: props.filter.range, accuracy: accuracy(props) }),
+		setValue: setReferrersValue,
+		setFetching: setReferrersFetching,
+		setError: setReferrersError
+	},
+	[metrics.METRICS_DURATIONS]: {
+		query: (props) => ({ type: props.durations.type }),
+		setValue: setDurationsValue,
+		setFetching: setDurationsFetching,
+		setError: setDurationsError
+	},
+	[metrics.METRICS_LANGUAGES]: {
+		query: (props) => ({ sorting: props.languages.sorting, range: props.filter.range, accuracy: accuracy(props) }),
+		setValue: setLanguagesValue,
+		setFetching: setLanguagesFetching,
+		setError: setLanguagesError
+	},
+	[metrics.METRICS_SIZES]: {
+		query: (props) => ({ type: props.sizes.type, range: props.filter.range, accuracy: accuracy(props) }),
+		setValue: setSizesValue,
+		setFetching: setSizesFetching,
+		setError: setSizesError
+	},
+	[metrics.METRICS_SYSTEMS]: {
+		query: (props) => ({ sorting: props.systems.sorting, type: props.systems.type, range: props.filter.range, accuracy: accuracy(props) }),
+		setValue: setSystemsValue,
+		setFetching: setSystemsFetching,
+		setError: setSystemsError
+	},
+	[metrics.METRICS_DEVICES]: {
+		query: (props) => ({ sorting: props.devices.sorting, type: props.devices.type, range: props.filter.range, accuracy: accuracy(props) }),
+		setValue: setDevicesValue,
+		setFetching: setDevicesFetching,
+		setError: setDevicesError
+	},
+	[metrics.METRICS_BROWSERS]: {
+		query: (props) => ({ sorting: props.browsers.sorting, type: props.browsers.type, range: props.filter.range, accuracy: accuracy(props) }),
+		setValue: setBrowsersValue,
+		setFetching: setBrowsersFetching,
+		setError: setBrowsersError
+	}
+}
+
+const createSearchParams = (props, metricNames, domainIds) => {
+
+	const searchParams = new URLSearchParams()
+
+	searchParams.append('metrics', metricNames.join(','))
+	searchParams.append('domainIds', domainIds.join(','))
+
+	metricNames.forEach((metric) => {
+		const query = handlers[metric].query(props)
+		Object.keys(query).forEach((key) => searchParams.append(`${ metric }.${ key }`, query[key]))
+	})
+
+	return searchParams
+
+}
+
+// Fetches the given metrics of all domains with a single request
+// and updates the cards of each metric and domain.
+export const fetchDashboard = signalHandler((signal) => (props, metricNames) => async (dispatch) => {
+
+	const domainIds = props.domains.value.map((domain) => domain.data.id)
+
+	// Nothing to fetch when there're no domains
+	if (domainIds.length === 0) return
+
+	const forEachCard = (fn) => metricNames.forEach((metric) => {
+		domainIds.forEach((domainId) => fn(handlers[metric], domainId))
+	})
+
+	forEachCard((handler, domainId) => {
+		dispatch(handler.setFetching(domainId, true))
+		dispatch(handler.setError(domainId))
+	})
+
+	const setValues = (data) => data.forEach(({ data }) => {
+		dispatch(handlers[data.metric].setValue(data.domainId, data.value.data))
+	})
+
+	try {
+
+		const data = await api(`/dashboard?${ createSearchParams(props, metricNames, domainIds) }`, {
+			method: 'get',
+			props,
+			signal: signal(metricNames.join(',')),
+			// Show the previous result right away while it's revalidated
+			onStale: setValues
+		})
+
+		// Request has been canceled by a newer one
+		if (data == null) return
+
+		setValues(data)
+
+		forEachCard((handler, domainId) => {
+			dispatch(handler.setFetching(domainId, false))
+		})
+
+	} catch (err) {
+
+		forEachCard((handler, domainId) => {
+			dispatch(handler.setError(domainId, err))
+			dispatch(handler.setFetching(domainId, false))
+		})
+
+	}
+
+})
@@ -12,6 +12,8 @@ export * from './sizes'
 export * from './systems'
 export * from './devices'
 export * from './browsers'
+export * from './dashboard'
+export * from './live'
 
 export const RESET_STATE = Symbol()
 
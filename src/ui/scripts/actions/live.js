@@ -0,0 +1,25 @@
+export const ADD_LIVE_RECORD = Symbol()
+
+export const addLiveRecord = (domainId, payload) => ({
+	type: ADD_LIVE_RECORD,
+	domainId,
+	payload
+})
+
+// Receives new records of all domains while the dashboard is open and applies them to the
+// loaded results. Returns a function that closes the connection.
+export const subscribeLive = (props) => (dispatch) => {
+
+	const token = props.token.value.id
+
+	// EventSource can't send headers
+	const source = new EventSource(`/dashboard/live?token=${ encodeURIComponent(token) }`)
+
+	source.addEventListener('record', (event) => {
+		const { domainId, ...payload } = JSON.parse(event.data)
+		dispatch(addLiveRecord(domainId, payload))
+	})
+
+	return () => source.close()
+
+}
@@ -1,5 +1,6 @@
 import api from '../utils/api'
 import signalHandler from '../utils/signalHandler'
+import * as storage from '../utils/storage'
 
 import { resetState } from './index'
 
@@ -52,6 +53,9 @@ export const deleteToken = signalHandler((signal) => (props) => async (dispatch)
 
 	dispatch(resetState())
 
+	// Cached results belong to the previous session
+	storage.resetResults()
+
 	try {
 
 		await api(`/tokens/${ props.token.value.id }`, {
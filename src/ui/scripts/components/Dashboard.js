@@ -1,4 +1,4 @@
-import { createElement as h } from 'react'
+import { createElement as h, useEffect } from 'react'
 
 import {
 	ROUTE_VIEWS,
@@ -41,6 +41,9 @@ const routesMap = {
 
 const Dashboard = (props) => {
 
+	// New records of domains that have been added later are only received after reconnecting
+	useEffect(() => props.subscribeLive(props), [ props.token.value.id, props.domains.value ])
+
 	return (
 		h('div', {},
 			h(Modals, props),
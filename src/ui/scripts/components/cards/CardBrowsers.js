@@ -11,12 +11,12 @@ import PresentationEmptyState, { ICON_LOADING, ICON_WARNING } from '../presentat
 import relativeDate from '../../utils/relativeDate'
 import rangeLabel from '../../utils/rangeLabel'
 
-const textLabel = (item, range, isRecent) => {
+const textLabel = (item, range, isRecent, isEstimated) => {
 
 	if (item && item.date) return relativeDate(item.date)
 	if (isRecent) return 'Recent'
 
-	return rangeLabel(range)
+	return rangeLabel(range, isEstimated)
 
 }
 
@@ -67,7 +67,8 @@ const CardBrowsers = (props) => {
 				}, textLabel(
 					props.items[active],
 					props.range,
-					props.sorting === BROWSERS_SORTING_RECENT
+					props.sorting === BROWSERS_SORTING_RECENT,
+					props.items.some((item) => item.estimated === true)
 				)),
 				presentation
 			)
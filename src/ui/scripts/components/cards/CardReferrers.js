@@ -10,7 +10,7 @@ import PresentationEmptyState, { ICON_LOADING, ICON_WARNING } from '../presentat
 import relativeDate from '../../utils/relativeDate'
 import rangeLabel from '../../utils/rangeLabel'
 
-const textLabel = (item, range, isRecent, isNew) => {
+const textLabel = (item, range, isRecent, isNew, isEstimated) => {
 
 	if (item && item.date) return relativeDate(item.date)
 	if (item && item.count) return `${ item.count } ${ item.count === 1 ? 'visit' : 'visits' }`
@@ -18,7 +18,7 @@ const textLabel = (item, range, isRecent, isNew) => {
 	if (isRecent) return 'Recent'
 	if (isNew) return 'New'
 
-	return rangeLabel(range)
+	return rangeLabel(range, isEstimated)
 
 }
 
@@ -66,7 +66,8 @@ const CardReferrers = (props) => {
 					props.items[active],
 					props.range,
 					props.sorting === REFERRERS_SORTING_RECENT,
-					props.sorting === REFERRERS_SORTING_NEW
+					props.sorting === REFERRERS_SORTING_NEW,
+					props.items.some((item) => item.estimated === true)
 				)),
 				presentation
 			)
@@ -7,9 +7,9 @@ import PresentationCounterList from '../presentations/PresentationCounterList'
 import PresentationEmptyState, { ICON_LOADING, ICON_WARNING } from '../presentations/PresentationEmptyState'
 import rangeLabel from '../../utils/rangeLabel'
 
-const textLabel = (range) => {
+const textLabel = (range, isEstimated) => {
 
-	return rangeLabel(range)
+	return rangeLabel(range, isEstimated)
 
 }
 
@@ -45,7 +45,7 @@ const CardSizes = (props) => {
 				}, props.headline),
 				h(Text, {
 					spacing: false
-				}, textLabel(props.range)),
+				}, textLabel(props.range, props.items.some((item) => item.estimated === true))),
 				presentation
 			)
 		)
@@ -1,5 +1,7 @@
 import { createElement as h, Fragment, useEffect } from 'react'
 
+import { METRICS_BROWSERS } from '../../../../constants/metrics'
+
 import selectBrowsersValue from '../../selectors/selectBrowsersValue'
 import enhanceBrowsers from '../../enhancers/enhanceBrowsers'
 import useDidMountEffect from '../../utils/useDidMountEffect'
@@ -16,9 +18,7 @@ const RouteBrowsers = (props) => {
 
 	useDidMountEffect(() => {
 
-		props.domains.value.map((domain) => {
-			props.fetchBrowsers(props, domain.data.id)
-		})
+		props.fetchDashboard(props, [ METRICS_BROWSERS ])
 
 	}, [ props.filter.range, props.domains.value, props.browsers.sorting, props.browsers.type ])
 
@@ -1,5 +1,7 @@
 import { createElement as h, Fragment, useEffect } from 'react'
 
+import { METRICS_DEVICES } from '../../../../constants/metrics'
+
 import selectDevicesValue from '../../selectors/selectDevicesValue'
 import enhanceDevices from '../../enhancers/enhanceDevices'
 import useDidMountEffect from '../../utils/useDidMountEffect'
@@ -16,9 +18,7 @@ const RouteDevices = (props) => {
 
 	useDidMountEffect(() => {
 
-		props.domains.value.map((domain) => {
-			props.fetchDevices(props, domain.data.id)
-		})
+		props.fetchDashboard(props, [ METRICS_DEVICES ])
 
 	}, [ props.filter.range, props.domains.value, props.devices.sorting, props.devices.type ])
 
@@ -1,5 +1,6 @@
 import { createElement as h, Fragment, useEffect } from 'react'
 
+import { METRICS_DURATIONS } from '../../../../constants/metrics'
 import { DURATIONS_TYPE_AVERAGE, DURATIONS_TYPE_DETAILED } from '../../../../constants/durations'
 
 import selectDurationsValue from '../../selectors/selectDurationsValue'
@@ -21,9 +22,7 @@ const RouteDurations = (props) => {
 
 	useDidMountEffect(() => {
 
-		props.domains.value.map((domain) => {
-			props.fetchDurations(props, domain.data.id)
-		})
+		props.fetchDashboard(props, [ METRICS_DURATIONS ])
 
 	}, [ props.domains.value, props.durations.type ])
 
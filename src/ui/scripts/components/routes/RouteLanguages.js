@@ -1,5 +1,7 @@
 import { createElement as h, Fragment, useEffect } from 'react'
 
+import { METRICS_LANGUAGES } from '../../../../constants/metrics'
+
 import selectLanguagesValue from '../../selectors/selectLanguagesValue'
 import enhanceLanguages from '../../enhancers/enhanceLanguages'
 import useDidMountEffect from '../../utils/useDidMountEffect'
@@ -16,9 +18,7 @@ const RouteLanguages = (props) => {
 
 	useDidMountEffect(() => {
 
-		props.domains.value.map((domain) => {
-			props.fetchLanguages(props, domain.data.id)
-		})
+		props.fetchDashboard(props, [ METRICS_LANGUAGES ])
 
 	}, [ props.filter.range, props.domains.value, props.languages.sorting ])
 
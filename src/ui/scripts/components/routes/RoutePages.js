@@ -1,5 +1,7 @@
 import { createElement as h, Fragment, useEffect } from 'react'
 
+import { METRICS_PAGES } from '../../../../constants/metrics'
+
 import selectPagesValue from '../../selectors/selectPagesValue'
 import enhancePages from '../../enhancers/enhancePages'
 import useDidMountEffect from '../../utils/useDidMountEffect'
@@ -16,9 +18,7 @@ const RoutePages = (props) => {
 
 	useDidMountEffect(() => {
 
-		props.domains.value.map((domain) => {
-			props.fetchPages(props, domain.data.id)
-		})
+		props.fetchDashboard(props, [ METRICS_PAGES ])
 
 	}, [ props.filter.range, props.domains.value, props.pages.sorting ])
 
@@ -1,5 +1,7 @@
 import { createElement as h, Fragment, useEffect } from 'react'
 
+import { METRICS_REFERRERS } from '../../../../constants/metrics'
+
 import selectReferrersValue from '../../selectors/selectReferrersValue'
 import enhanceReferrers from '../../enhancers/enhanceReferrers'
 import useDidMountEffect from '../../utils/useDidMountEffect'
@@ -16,9 +18,7 @@ const RouteReferrers = (props) => {
 
 	useDidMountEffect(() => {
 
-		props.domains.value.map((domain) => {
-			props.fetchReferrers(props, domain.data.id)
-		})
+		props.fetchDashboard(props, [ METRICS_REFERRERS ])
 
 	}, [ props.filter.range, props.domains.value, props.referrers.sorting ])
 
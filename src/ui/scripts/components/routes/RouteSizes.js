@@ -1,5 +1,7 @@
 import { createElement as h, Fragment, useEffect } from 'react'
 
+import { METRICS_SIZES } from '../../../../constants/metrics'
+
 import selectSizesValue from '../../selectors/selectSizesValue'
 import enhanceSizes from '../../enhancers/enhanceSizes'
 import useDidMountEffect from '../../utils/useDidMountEffect'
@@ -16,9 +18,7 @@ const RouteSizes = (props) => {
 
 	useDidMountEffect(() => {
 
-		props.domains.value.map((domain) => {
-			props.fetchSizes(props, domain.data.id)
-		})
+		props.fetchDashboard(props, [ METRICS_SIZES ])
 
 	}, [ props.filter.range, props.domains.value, props.sizes.type ])
 
@@ -1,5 +1,7 @@
 import { createElement as h, Fragment, useEffect } from 'react'
 
+import { METRICS_SYSTEMS } from '../../../../constants/metrics'
+
 import selectSystemsValue from '../../selectors/selectSystemsValue'
 import enhanceSystems from '../../enhancers/enhanceSystems'
 import useDidMountEffect from '../../utils/useDidMountEffect'
@@ -16,9 +18,7 @@ const RouteSystems = (props) => {
 
 	useDidMountEffect(() => {
 
-		props.domains.value.map((domain) => {
-			props.fetchSystems(props, domain.data.id)
-		})
+		props.fetchDashboard(props, [ METRICS_SYSTEMS ])
 
 	}, [ props.filter.range, props.domains.value, props.systems.sorting, props.systems.type ])
 
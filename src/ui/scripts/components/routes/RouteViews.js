@@ -1,5 +1,6 @@
 import { createElement as h, Fragment, useEffect } from 'react'
 
+import { METRICS_VIEWS } from '../../../../constants/metrics'
 import { VIEWS_TYPE_UNIQUE, VIEWS_TYPE_TOTAL } from '../../../../constants/views'
 
 import selectViewsValue from '../../selectors/selectViewsValue'
@@ -19,9 +20,7 @@ const RouteViews = (props) => {
 
 	useDidMountEffect(() => {
 
-		props.domains.value.map((domain) => {
-			props.fetchViews(props, domain.data.id)
-		})
+		props.fetchDashboard(props, [ METRICS_VIEWS ])
 
 	}, [ props.domains.value, props.views.type, props.views.interval ])
 
@@ -14,6 +14,7 @@ export default (browsers) => {
 	return browsers.map((browser) => ({
 		text: getText(browser.data),
 		count: browser.data.count,
+		estimated: browser.data.estimated === true,
 		date: browser.data.created == null ? null : new Date(browser.data.created)
 	}))
 
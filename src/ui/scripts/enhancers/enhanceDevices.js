@@ -14,6 +14,7 @@ export default (devices) => {
 	return devices.map((device) => ({
 		text: getText(device.data),
 		count: device.data.count,
+		estimated: device.data.estimated === true,
 		date: device.data.created == null ? null : new Date(device.data.created)
 	}))
 
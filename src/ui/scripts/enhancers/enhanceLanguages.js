@@ -6,6 +6,7 @@ export default (languages) => {
 	return languages.map((language) => ({
 		text: languageCodes[language.data.id] || language.data.id,
 		count: language.data.count,
+		estimated: language.data.estimated === true,
 		date: language.data.created == null ? null : new Date(language.data.created)
 	}))
 
@@ -5,6 +5,7 @@ export default (pages) => {
 		url: new URL(page.data.id),
 		text: new URL(page.data.id).href,
 		count: page.data.count,
+		estimated: page.data.estimated === true,
 		date: page.data.created == null ? null : new Date(page.data.created)
 	}))
 
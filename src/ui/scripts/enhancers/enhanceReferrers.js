@@ -5,6 +5,7 @@ export default (referrers) => {
 		url: new URL(referrer.data.id),
 		text: new URL(referrer.data.id).href,
 		count: referrer.data.count,
+		estimated: referrer.data.estimated === true,
 		date: referrer.data.created == null ? null : new Date(referrer.data.created)
 	}))
 
@@ -15,7 +15,8 @@ export default (sizes) => {
 	// Extract and enhance the data from the API
 	return sizes.map((size) => ({
 		text: getText(size.data),
-		count: size.data.count
+		count: size.data.count,
+		estimated: size.data.estimated === true
 	}))
 
 }
\ No newline at end of file
@@ -14,6 +14,7 @@ export default (systems) => {
 	return systems.map((system) => ({
 		text: getText(system.data),
 		count: system.data.count,
+		estimated: system.data.estimated === true,
 		date: system.data.created == null ? null : new Date(system.data.created)
 	}))
 
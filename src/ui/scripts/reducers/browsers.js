@@ -5,10 +5,14 @@ import {
 	SET_BROWSERS_FETCHING,
 	SET_BROWSERS_SORTING,
 	SET_BROWSERS_VALUE,
-	SET_BROWSERS_TYPE
+	SET_BROWSERS_TYPE,
+	ADD_LIVE_RECORD
 } from '../actions'
 
-import { BROWSERS_SORTING_TOP, BROWSERS_TYPE_NO_VERSION } from '../../../constants/browsers'
+import { BROWSERS_SORTING_TOP, BROWSERS_SORTING_RECENT, BROWSERS_TYPE_NO_VERSION } from '../../../constants/browsers'
+
+import mergeRecord from '../utils/mergeRecord'
+import pickRecordId from '../utils/pickRecordId'
 
 export const initialState = () => ({
 	type: BROWSERS_TYPE_NO_VERSION,
@@ -51,6 +55,9 @@ export default produce((draft, action) => {
 		case SET_BROWSERS_ERROR:
 			draft.value[action.domainId].error = action.payload || initialSubState().error
 			break
+		case ADD_LIVE_RECORD:
+			mergeRecord(draft.value[action.domainId].value, pickRecordId(action.payload, draft.type === BROWSERS_TYPE_NO_VERSION ? [ 'browserName' ] : [ 'browserName', 'browserVersion' ]), action.payload.created, draft.sorting === BROWSERS_SORTING_RECENT)
+			break
 	}
 
 }, initialState())
\ No newline at end of file
@@ -5,10 +5,14 @@ import {
 	SET_DEVICES_FETCHING,
 	SET_DEVICES_SORTING,
 	SET_DEVICES_VALUE,
-	SET_DEVICES_TYPE
+	SET_DEVICES_TYPE,
+	ADD_LIVE_RECORD
 } from '../actions'
 
-import { DEVICES_SORTING_TOP, DEVICES_TYPE_WITH_MODEL } from '../../../constants/devices'
+import { DEVICES_SORTING_TOP, DEVICES_SORTING_RECENT, DEVICES_TYPE_WITH_MODEL } from '../../../constants/devices'
+
+import mergeRecord from '../utils/mergeRecord'
+import pickRecordId from '../utils/pickRecordId'
 
 export const initialState = () => ({
 	type: DEVICES_TYPE_WITH_MODEL,
@@ -51,6 +55,9 @@ export default produce((draft, action) => {
 		case SET_DEVICES_ERROR:
 			draft.value[action.domainId].error = action.payload || initialSubState().error
 			break
+		case ADD_LIVE_RECORD:
+			mergeRecord(draft.value[action.domainId].value, pickRecordId(action.payload, draft.type === DEVICES_TYPE_WITH_MODEL ? [ 'deviceManufacturer', 'deviceName' ] : [ 'deviceManufacturer' ]), action.payload.created, draft.sorting === DEVICES_SORTING_RECENT)
+			break
 	}
 
 }, initialState())
\ No newline at end of file
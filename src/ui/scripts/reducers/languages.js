@@ -4,10 +4,14 @@ import {
 	SET_LANGUAGES_SORTING,
 	SET_LANGUAGES_VALUE,
 	SET_LANGUAGES_FETCHING,
-	SET_LANGUAGES_ERROR
+	SET_LANGUAGES_ERROR,
+	ADD_LIVE_RECORD
 } from '../actions'
 
-import { LANGUAGES_SORTING_TOP } from '../../../constants/languages'
+import { LANGUAGES_SORTING_TOP, LANGUAGES_SORTING_RECENT } from '../../../constants/languages'
+
+import mergeRecord from '../utils/mergeRecord'
+import pickRecordId from '../utils/pickRecordId'
 
 export const initialState = () => ({
 	sorting: LANGUAGES_SORTING_TOP,
@@ -43,6 +47,9 @@ export default produce((draft, action) => {
 		case SET_LANGUAGES_ERROR:
 			draft.value[action.domainId].error = action.payload || initialSubState().error
 			break
+		case ADD_LIVE_RECORD:
+			mergeRecord(draft.value[action.domainId].value, pickRecordId(action.payload, [ 'siteLanguage' ]), action.payload.created, draft.sorting === LANGUAGES_SORTING_RECENT)
+			break
 	}
 
 }, initialState())
\ No newline at end of file
@@ -4,10 +4,14 @@ import {
 	SET_PAGES_SORTING,
 	SET_PAGES_VALUE,
 	SET_PAGES_FETCHING,
-	SET_PAGES_ERROR
+	SET_PAGES_ERROR,
+	ADD_LIVE_RECORD
 } from '../actions'
 
-import { PAGES_SORTING_TOP } from '../../../constants/pages'
+import { PAGES_SORTING_TOP, PAGES_SORTING_RECENT } from '../../../constants/pages'
+
+import mergeRecord from '../utils/mergeRecord'
+import pickRecordId from '../utils/pickRecordId'
 
 export const initialState = () => ({
 	sorting: PAGES_SORTING_TOP,
@@ -43,6 +47,9 @@ export default produce((draft, action) => {
 		case SET_PAGES_ERROR:
 			draft.value[action.domainId].error = action.payload || initialSubState().error
 			break
+		case ADD_LIVE_RECORD:
+			mergeRecord(draft.value[action.domainId].value, pickRecordId(action.payload, [ 'siteLocation' ]), action.payload.created, draft.sorting === PAGES_SORTING_RECENT)
+			break
 	}
 
 }, initialState())
\ No newline at end of file
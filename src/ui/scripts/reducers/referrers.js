@@ -4,10 +4,14 @@ import {
 	SET_REFERRERS_SORTING,
 	SET_REFERRERS_VALUE,
 	SET_REFERRERS_FETCHING,
-	SET_REFERRERS_ERROR
+	SET_REFERRERS_ERROR,
+	ADD_LIVE_RECORD
 } from '../actions'
 
-import { REFERRERS_SORTING_TOP } from '../../../constants/referrers'
+import { REFERRERS_SORTING_TOP, REFERRERS_SORTING_NEW, REFERRERS_SORTING_RECENT } from '../../../constants/referrers'
+
+import mergeRecord from '../utils/mergeRecord'
+import pickRecordId from '../utils/pickRecordId'
 
 export const initialState = () => ({
 	sorting: REFERRERS_SORTING_TOP,
@@ -43,6 +47,11 @@ export default produce((draft, action) => {
 		case SET_REFERRERS_ERROR:
 			draft.value[action.domainId].error = action.payload || initialSubState().error
 			break
+		case ADD_LIVE_RECORD:
+			// New referrers can't be known without the previous records
+			if (draft.sorting === REFERRERS_SORTING_NEW) break
+			mergeRecord(draft.value[action.domainId].value, pickRecordId(action.payload, [ 'siteReferrer' ]), action.payload.created, draft.sorting === REFERRERS_SORTING_RECENT)
+			break
 	}
 
 }, initialState())
\ No newline at end of file
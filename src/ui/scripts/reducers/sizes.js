@@ -4,10 +4,31 @@ import {
 	SET_SIZES_TYPE,
 	SET_SIZES_VALUE,
 	SET_SIZES_FETCHING,
-	SET_SIZES_ERROR
+	SET_SIZES_ERROR,
+	ADD_LIVE_RECORD
 } from '../actions'
 
-import { SIZES_TYPE_BROWSER_RESOLUTION } from '../../../constants/sizes'
+import {
+	SIZES_TYPE_BROWSER_HEIGHT,
+	SIZES_TYPE_BROWSER_RESOLUTION,
+	SIZES_TYPE_BROWSER_WIDTH,
+	SIZES_TYPE_SCREEN_HEIGHT,
+	SIZES_TYPE_SCREEN_RESOLUTION,
+	SIZES_TYPE_SCREEN_WIDTH
+} from '../../../constants/sizes'
+
+import mergeRecord from '../utils/mergeRecord'
+import pickRecordId from '../utils/pickRecordId'
+
+// Properties of the results of each type
+const properties = {
+	[SIZES_TYPE_BROWSER_HEIGHT]: [ 'browserHeight' ],
+	[SIZES_TYPE_BROWSER_RESOLUTION]: [ 'browserWidth', 'browserHeight' ],
+	[SIZES_TYPE_BROWSER_WIDTH]: [ 'browserWidth' ],
+	[SIZES_TYPE_SCREEN_HEIGHT]: [ 'screenHeight' ],
+	[SIZES_TYPE_SCREEN_RESOLUTION]: [ 'screenWidth', 'screenHeight' ],
+	[SIZES_TYPE_SCREEN_WIDTH]: [ 'screenWidth' ]
+}
 
 export const initialState = () => ({
 	type: SIZES_TYPE_BROWSER_RESOLUTION,
@@ -43,6 +64,9 @@ export default produce((draft, action) => {
 		case SET_SIZES_ERROR:
 			draft.value[action.domainId].error = action.payload || initialSubState().error
 			break
+		case ADD_LIVE_RECORD:
+			mergeRecord(draft.value[action.domainId].value, pickRecordId(action.payload, properties[draft.type]), action.payload.created, false)
+			break
 	}
 
 }, initialState())
\ No newline at end of file
@@ -5,10 +5,14 @@ import {
 	SET_SYSTEMS_FETCHING,
 	SET_SYSTEMS_SORTING,
 	SET_SYSTEMS_VALUE,
-	SET_SYSTEMS_TYPE
+	SET_SYSTEMS_TYPE,
+	ADD_LIVE_RECORD
 } from '../actions'
 
-import { SYSTEMS_SORTING_TOP, SYSTEMS_TYPE_NO_VERSION } from '../../../constants/systems'
+import { SYSTEMS_SORTING_TOP, SYSTEMS_SORTING_RECENT, SYSTEMS_TYPE_NO_VERSION } from '../../../constants/systems'
+
+import mergeRecord from '../utils/mergeRecord'
+import pickRecordId from '../utils/pickRecordId'
 
 export const initialState = () => ({
 	type: SYSTEMS_TYPE_NO_VERSION,
@@ -51,6 +55,9 @@ export default produce((draft, action) => {
 		case SET_SYSTEMS_ERROR:
 			draft.value[action.domainId].error = action.payload || initialSubState().error
 			break
+		case ADD_LIVE_RECORD:
+			mergeRecord(draft.value[action.domainId].value, pickRecordId(action.payload, draft.type === SYSTEMS_TYPE_NO_VERSION ? [ 'osName' ] : [ 'osName', 'osVersion' ]), action.payload.created, draft.sorting === SYSTEMS_SORTING_RECENT)
+			break
 	}
 
 }, initialState())
\ No newline at end of file
@@ -5,11 +5,14 @@ import {
 	SET_VIEWS_INTERVAL,
 	SET_VIEWS_VALUE,
 	SET_VIEWS_FETCHING,
-	SET_VIEWS_ERROR
+	SET_VIEWS_ERROR,
+	ADD_LIVE_RECORD
 } from '../actions'
 
 import { VIEWS_TYPE_UNIQUE, VIEWS_INTERVAL_DAILY } from '../../../constants/views'
 
+import mergeRecordViews from '../utils/mergeRecordViews'
+
 export const initialState = () => ({
 	type: VIEWS_TYPE_UNIQUE,
 	interval: VIEWS_INTERVAL_DAILY,
@@ -45,6 +48,11 @@ export default produce((draft, action) => {
 		case SET_VIEWS_ERROR:
 			draft.value[action.domainId].error = action.payload || initialSubState().error
 			break
+		case ADD_LIVE_RECORD:
+			// Only the first record of a user per day is a unique view. Unique views of longer intervals can't be counted.
+			if (draft.type === VIEWS_TYPE_UNIQUE && (action.payload.unique !== true || draft.interval !== VIEWS_INTERVAL_DAILY)) break
+			mergeRecordViews(draft.value[action.domainId].value, action.payload.created, draft.interval)
+			break
 	}
 
 }, initialState())
\ No newline at end of file
@@ -1,6 +1,9 @@
 import timeout from './timeout'
+import * as storage from './storage'
 
-export default async (url, { props, method, body, signal }) => {
+// Results of GET requests are cached with their ETag. A cached result is passed to onStale
+// while it's revalidated and returned when it's still current.
+export default async (url, { props, method, body, signal, onStale }) => {
 
 	try {
 
@@ -9,6 +12,13 @@ export default async (url, { props, method, body, signal }) => {
 
 		if (token) headers.append('Authorization', `Bearer ${ token }`)
 
+		const cachedResult = method === 'get' ? storage.loadResult(url) : undefined
+
+		if (cachedResult != null) {
+			headers.append('If-None-Match', cachedResult.etag)
+			if (onStale != null) onStale(cachedResult.data)
+		}
+
 		const request = fetch(url, {
 			headers,
 			method,
@@ -18,6 +28,10 @@ export default async (url, { props, method, body, signal }) => {
 
 		const response = await timeout(request, 'Request timeout', 30000)
 
+		if (response.status === 304 && cachedResult != null) {
+			return cachedResult.data
+		}
+
 		if (response.ok === false) {
 			const text = await response.text()
 			throw new Error(text)
@@ -34,6 +48,8 @@ export default async (url, { props, method, body, signal }) => {
 
 		if (isJSON === true) {
 			const json = await response.json()
+			const etag = response.headers.get('etag')
+			if (method === 'get' && etag != null) storage.saveResult(url, etag, json.data)
 			return json.data
 		}
 
@@ -0,0 +1,34 @@
+// Results of the API contain at most 30 entries
+const limit = 30
+
+const isSameId = (a, b) => {
+
+	const isObject = typeof a === 'object' && typeof b === 'object' && a != null && b != null
+
+	if (isObject === false) return a === b
+
+	return Object.keys(a).every((key) => a[key] === b[key])
+
+}
+
+// Adds a new record to the top or recent entries of a metric. Must be called with a draft of immer.
+export default (entries, id, created, isRecent) => {
+
+	// Records without the value aren't part of the results
+	if (id == null) return
+
+	if (isRecent === true) {
+		entries.unshift({ data: { id, created } })
+		entries.splice(limit)
+		return
+	}
+
+	const entry = entries.find((entry) => isSameId(entry.data.id, id))
+
+	if (entry == null) entries.push({ data: { id, count: 1 } })
+	else entry.data.count++
+
+	entries.sort((a, b) => b.data.count - a.data.count)
+	entries.splice(limit)
+
+}
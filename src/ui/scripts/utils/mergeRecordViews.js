@@ -0,0 +1,41 @@
+import {
+	VIEWS_INTERVAL_DAILY,
+	VIEWS_INTERVAL_MONTHLY
+} from '../../../constants/views'
+
+import matchesDate from './matchesDate'
+
+// Counts a new record in the views of its day, month or year. Must be called with a draft of immer.
+export default (entries, created, interval) => {
+
+	const matchDay = [ VIEWS_INTERVAL_DAILY ].includes(interval)
+	const matchMonth = [ VIEWS_INTERVAL_DAILY, VIEWS_INTERVAL_MONTHLY ].includes(interval)
+
+	const date = new Date(created)
+
+	const entry = entries.find((entry) => {
+		return matchesDate(
+			matchDay === true ? entry.data.id.day : undefined,
+			matchMonth === true ? entry.data.id.month : undefined,
+			entry.data.id.year,
+			date
+		)
+	})
+
+	if (entry != null) {
+		entry.data.count++
+		return
+	}
+
+	entries.unshift({
+		data: {
+			id: {
+				day: matchDay === true ? date.getDate() : undefined,
+				month: matchMonth === true ? date.getMonth() + 1 : undefined,
+				year: date.getFullYear()
+			},
+			count: 1
+		}
+	})
+
+}
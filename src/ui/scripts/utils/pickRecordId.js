@@ -0,0 +1,14 @@
+// Returns the id a record has in the results of the given properties. Records
+// without one of the properties aren't part of the results.
+export default (record, properties) => {
+
+	if (properties.some((property) => record[property] == null)) return
+
+	if (properties.length === 1) return record[properties[0]]
+
+	return properties.reduce((acc, property) => {
+		acc[property] = record[property]
+		return acc
+	}, {})
+
+}
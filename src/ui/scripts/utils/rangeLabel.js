@@ -1,12 +1,15 @@
 import ranges from '../../../constants/ranges'
 
-export default (range) => {
+export default (range, isEstimated = false) => {
 
-	return ({
+	const label = ({
 		[ranges.RANGES_LAST_24_HOURS]: 'Last 24 hours',
 		[ranges.RANGES_LAST_7_DAYS]: 'Last 7 days',
 		[ranges.RANGES_LAST_30_DAYS]: 'Last 30 days',
 		[ranges.RANGES_ALL_TIME]: 'All time'
 	})[range]
 
+	// Approximate results are calculated from a sample of the records
+	return isEstimated === true ? `${ label } (estimated)` : label
+
 }
\ No newline at end of file
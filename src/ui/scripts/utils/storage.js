@@ -3,6 +3,12 @@ import { version } from '../../../../package'
 // Should include the package version so we can increase the version number
 // when the structure of the state has changed to avoid loading outdated states.
 const PERSISTED_STATE_KEY = `ackee_state_${ version }`
+const RESULTS_KEY = `ackee_results_${ version }`
+
+// Number of results kept to show them while they're revalidated
+const RESULTS_LIMIT = 50
+
+let results
 
 export const load = () => {
 
@@ -25,5 +31,47 @@ export const save = (state) => {
 export const reset = () => {
 
 	localStorage.removeItem(PERSISTED_STATE_KEY)
+	resetResults()
+
+}
+
+const loadResults = () => {
+
+	if (results != null) return results
+
+	try {
+		results = JSON.parse(localStorage.getItem(RESULTS_KEY)) || []
+	} catch (err) {
+		results = []
+	}
+
+	return results
+
+}
+
+export const loadResult = (url) => {
+
+	return loadResults().find((entry) => entry.url === url)
+
+}
+
+// Saves the result of a request with its ETag. The most recent results are kept.
+export const saveResult = (url, etag, data) => {
+
+	results = [ { url, etag, data }, ...loadResults().filter((entry) => entry.url !== url) ].slice(0, RESULTS_LIMIT)
+
+	try {
+		localStorage.setItem(RESULTS_KEY, JSON.stringify(results))
+	} catch (err) {
+		// The quota of the storage might be exceeded. Results are still kept in memory.
+		localStorage.removeItem(RESULTS_KEY)
+	}
+
+}
+
+export const resetResults = () => {
+
+	results = []
+	localStorage.removeItem(RESULTS_KEY)
 
 }
\ No newline at end of file
@@ -0,0 +1,54 @@
+'use strict'
+
+const { createConnection } = require('./connect')
+
+const dbUrl = process.env.ACKEE_ANALYTICS_MONGODB
+const readPreference = process.env.ACKEE_READ_PREFERENCE || 'secondaryPreferred'
+const maxStalenessSeconds = Number.parseInt(process.env.ACKEE_MAX_STALENESS)
+
+// Aggregations of the dashboard can run on their own connection, e.g. to read from secondaries.
+// Writes and the reads that must see them always use the default connection.
+const enabled = dbUrl != null || process.env.ACKEE_READ_PREFERENCE != null || maxStalenessSeconds > 0
+
+// Maximum time in ms results might lag behind the primary. MongoDB uses at least 90 seconds.
+const staleness = (maxStalenessSeconds > 0 ? maxStalenessSeconds : 90) * 1000
+
+let connection
+
+const connect = async (defaultDbUrl) => {
+
+	if (enabled === false) return
+
+	const options = {
+		readPreference,
+		// Indexes are built by the default connection
+		autoIndex: false
+	}
+
+	// Staleness can't be combined with reads from the primary
+	if (maxStalenessSeconds > 0 && readPreference !== 'primary') options.maxStalenessSeconds = maxStalenessSeconds
+
+	connection = await createConnection(dbUrl || defaultDbUrl, options)
+
+	return connection
+
+}
+
+// Returns the model on the connection of the aggregations. Falls back to the
+// model of the default connection when no separate connection has been opened.
+const model = (Model) => {
+
+	if (connection == null) return Model
+
+	if (connection.models[Model.modelName] == null) connection.model(Model.modelName, Model.schema)
+
+	return connection.models[Model.modelName]
+
+}
+
+module.exports = {
+	enabled,
+	staleness,
+	connect,
+	model
+}
@@ -0,0 +1,70 @@
+'use strict'
+
+const redis = require('./redis')
+const signale = require('./signale')
+const versions = require('./versions')
+const analytics = require('./analytics')
+const createCache = require('./createCache')
+const dayKey = require('./dayKey')
+const { minute, day } = require('./times')
+
+const metrics = process.env.ACKEE_CACHE == null ? [] : process.env.ACKEE_CACHE.split(',')
+const staleness = process.env.ACKEE_CACHE_STALENESS == null ? minute : Number.parseInt(process.env.ACKEE_CACHE_STALENESS)
+
+const localCache = createCache({
+	max: 1000,
+	ttl: day
+})
+
+const store = redis == null ? {
+	get: async (key) => localCache.get(key),
+	set: async (key, entry) => localCache.set(key, entry)
+} : {
+	get: async (key) => JSON.parse(await redis.command('GET', `ackee:cache:${ key }`)),
+	set: async (key, entry) => redis.command('SET', `ackee:cache:${ key }`, JSON.stringify(entry), 'PX', day)
+}
+
+// Wraps a function that returns the entries of a metric. Results are reused as long as
+// they're younger than the staleness bound or, with versions shared through Redis, as long as
+// no new data has been added to the domain. Only enabled for metrics included in `ACKEE_CACHE`.
+module.exports = (metric, name, fn) => {
+
+	if (metrics.includes(metric) === false) return fn
+
+	return async (id, ...args) => {
+
+		// Ranges are relative to the current day and change with it
+		const key = JSON.stringify([ metric, name, id, ...args, dayKey() ])
+
+		let version
+
+		try {
+
+			version = await versions.get(id)
+			const entry = await store.get(key)
+
+			// Local versions don't include data added by other processes. Results read from
+			// secondaries might not include the data of their version yet.
+			const isCurrent = entry != null && versions.shared === true && analytics.enabled === false && entry.version === version
+			const isFresh = entry != null && Date.now() - entry.created < staleness
+
+			if (isCurrent === true || isFresh === true) return entry.value
+
+		} catch (err) {
+
+			signale.warn(`Failed to read cache: ${ err.message }`)
+			return fn(id, ...args)
+
+		}
+
+		const value = await fn(id, ...args)
+
+		store.set(key, { value, version, created: Date.now() }).catch((err) => {
+			signale.warn(`Failed to write cache: ${ err.message }`)
+		})
+
+		return value
+
+	}
+
+}
@@ -0,0 +1,139 @@
+'use strict'
+
+// Paths that are managed by MongoDB and mongoose
+const internalPaths = [ '_id', '__v' ]
+
+const format = (template, values) => Object.keys(values).reduce((acc, key) => {
+	return acc.split(`{${ key }}`).join(values[key])
+}, template)
+
+// Casts values the same way as mongoose. Returns undefined when the value can't be cast.
+const casts = {
+	String: (value) => {
+		if (typeof value === 'string') return value
+		if (typeof value === 'number' || typeof value === 'boolean') return String(value)
+	},
+	Number: (value) => {
+		if (typeof value === 'number') return Number.isFinite(value) === true ? value : undefined
+		if (typeof value === 'boolean') return value === true ? 1 : 0
+		if (typeof value === 'string' && value.trim() !== '' && Number.isNaN(Number(value)) === false) return Number(value)
+	},
+	Date: (value) => {
+		if (value instanceof Date === false && typeof value !== 'number' && typeof value !== 'string') return
+		const date = value instanceof Date ? value : new Date(typeof value === 'string' && /^\d+$/.test(value) === true ? Number(value) : value)
+		if (Number.isNaN(date.getTime()) === false) return date
+	}
+}
+
+const compilePath = (path, schemaType, messages) => {
+
+	const { options } = schemaType
+	const cast = casts[schemaType.instance]
+
+	if (cast == null) throw new Error(`Unsupported type \`${ schemaType.instance }\` of path \`${ path }\``)
+
+	const checks = []
+	const check = (test, template, values) => checks.push({ test, template, values })
+
+	// Like mongoose, required strings must not be empty
+	const isEmpty = (value) => value == null || (schemaType.instance === 'String' && value === '')
+
+	if (options.required === true) check((value) => isEmpty(value) === false, messages.general.required, {})
+
+	// Limits only apply to existing values
+	if (options.min != null) check((value) => value == null || value >= options.min, messages.Number.min, { MIN: options.min })
+	if (options.max != null) check((value) => value == null || value <= options.max, messages.Number.max, { MAX: options.max })
+	if (options.minlength != null) check((value) => value == null || value.length >= options.minlength, messages.String.minlength, { MINLENGTH: options.minlength })
+	if (options.maxlength != null) check((value) => value == null || value.length <= options.maxlength, messages.String.maxlength, { MAXLENGTH: options.maxlength })
+
+	// Custom validators don't run for missing values
+	const validators = options.validate == null ? [] : [].concat(options.validate)
+
+	validators.forEach((validator) => {
+		const fn = typeof validator === 'function' ? validator : validator.validator
+		const template = typeof validator === 'function' || validator.message == null ? messages.general.default : validator.message
+		check((value) => value === undefined || fn(value) === true, template, {})
+	})
+
+	return {
+		path,
+		cast,
+		checks,
+		default: options.default,
+		type: schemaType.instance
+	}
+
+}
+
+// Compiles the paths of a mongoose schema into a function that casts, defaults and validates
+// plain objects without creating documents. Unknown properties are removed like in strict mode.
+// Throws a ValidationError with the same messages as mongoose.
+module.exports = (schema, messages) => {
+
+	const paths = Object.keys(schema.paths)
+		.filter((path) => internalPaths.includes(path) === false)
+		.map((path) => compilePath(path, schema.paths[path], messages))
+
+	const versionKey = schema.options.versionKey
+
+	return (data) => {
+
+		const document = {}
+		const errors = {}
+
+		paths.forEach((path) => {
+
+			let value = data[path.path]
+
+			// Defaults are applied in the order of the schema and can depend on previous paths
+			if (value === undefined && path.default !== undefined) {
+				value = typeof path.default === 'function' ? path.default.call(document) : path.default
+			}
+
+			if (value != null) {
+
+				const castedValue = path.cast(value)
+
+				if (castedValue === undefined) {
+					errors[path.path] = {
+						message: `Cast to ${ path.type } failed for value ${ JSON.stringify(value) } at path "${ path.path }"`,
+						path: path.path,
+						value
+					}
+					return
+				}
+
+				value = castedValue
+
+			}
+
+			const failedCheck = path.checks.find((check) => check.test(value) === false)
+
+			if (failedCheck != null) {
+				errors[path.path] = {
+					message: format(failedCheck.template, { ...failedCheck.values, PATH: path.path, VALUE: value }),
+					path: path.path,
+					value
+				}
+				return
+			}
+
+			if (value !== undefined) document[path.path] = value
+
+		})
+
+		if (Object.keys(errors).length > 0) {
+			const err = new Error(`Validation failed: ${ Object.keys(errors).map((key) => errors[key].message).join(', ') }`)
+			err.name = 'ValidationError'
+			err.errors = errors
+			throw err
+		}
+
+		// New documents of mongoose start with version 0
+		if (versionKey != null && versionKey !== false) document[versionKey] = 0
+
+		return document
+
+	}
+
+}
@@ -0,0 +1,43 @@
+'use strict'
+
+const crypto = require('crypto')
+
+const versions = require('./versions')
+const analytics = require('./analytics')
+const dayKey = require('./dayKey')
+const { minute } = require('./times')
+
+const domainDependencies = (req) => [ req.params.domainId ]
+
+// Local versions don't include data added by other processes and results read from secondaries
+// might not include the data of the current version yet. Their ETags also change periodically.
+const staleness = versions.shared === false ? minute : analytics.enabled === true ? analytics.staleness : undefined
+
+const period = () => staleness == null ? '' : Math.floor(Date.now() / staleness)
+
+// Answers requests with `304 Not Modified` when the client already has the current result.
+// The ETag changes with the versions of the data the result depends on, the URL and the day,
+// as ranges are relative to it. The wrapped function only runs when the result changed.
+module.exports = (fn, dependencies = domainDependencies) => async (req, res) => {
+
+	const tag = await versions.tag(await dependencies(req))
+	const etag = `W/"${ crypto.createHash('sha1').update(`${ tag }${ req.url }${ dayKey() }${ period() }`).digest('base64') }"`
+
+	// Results must be revalidated before they're used again
+	res.setHeader('Cache-Control', 'private, no-cache')
+
+	if (req.headers['if-none-match'] === etag) {
+		res.setHeader('ETag', etag)
+		res.statusCode = 304
+		res.end()
+		return
+	}
+
+	const result = await fn(req, res)
+
+	// Errors of the function don't include an ETag
+	res.setHeader('ETag', etag)
+
+	return result
+
+}
@@ -0,0 +1,30 @@
+'use strict'
+
+const mongoose = require('mongoose')
+
+const monitoring = require('./monitoring')
+
+mongoose.set('useFindAndModify', false)
+
+const options = {
+
+	useNewUrlParser: true,
+	useCreateIndex: true,
+	reconnectTries: Number.MAX_VALUE,
+	reconnectInterval: 1000,
+	// Durations of commands are only collected for the metrics endpoint
+	monitorCommands: monitoring.enabled
+
+}
+
+module.exports = (dbUrl) => mongoose.connect(dbUrl, options)
+
+// Opens an additional connection with its own pool and resolves once it's connected
+module.exports.createConnection = (dbUrl, additionalOptions) => new Promise((resolve, reject) => {
+
+	const connection = mongoose.createConnection(dbUrl, { ...options, ...additionalOptions })
+
+	connection.once('open', () => resolve(connection))
+	connection.once('error', reject)
+
+})
\ No newline at end of file
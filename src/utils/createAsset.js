@@ -0,0 +1,30 @@
+'use strict'
+
+const crypto = require('crypto')
+const zlib = require('zlib')
+
+// Brotli is only available in Node.js >= 10.16
+const hasBrotli = typeof zlib.brotliCompressSync === 'function'
+
+const brotliOptions = hasBrotli === true ? {
+	params: {
+		[zlib.constants.BROTLI_PARAM_QUALITY]: zlib.constants.BROTLI_MAX_QUALITY
+	}
+} : undefined
+
+// Prepares a file so it can be sent without further work. Compressed variants are
+// computed when they aren't passed, e.g. because they have been built before.
+module.exports = ({ content, type, gzip, brotli }) => {
+
+	const data = Buffer.from(content)
+	const hash = crypto.createHash('sha256').update(data).digest('hex').slice(0, 16)
+
+	return {
+		type,
+		hash,
+		content: data,
+		gzip: gzip != null ? gzip : zlib.gzipSync(data, { level: zlib.constants.Z_BEST_COMPRESSION }),
+		brotli: brotli != null ? brotli : (hasBrotli === true ? zlib.brotliCompressSync(data, brotliOptions) : undefined)
+	}
+
+}
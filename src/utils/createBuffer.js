@@ -0,0 +1,120 @@
+'use strict'
+
+const signale = require('./signale')
+
+// Collects values by key and passes them to `flush` once `size` values are buffered or
+// `interval` ms passed since the first value has been added. Setting an existing key
+// replaces its value, so repeated writes of the same entry are coalesced.
+// Values of a failed flush are buffered again and retried with the next one. A flush can
+// reject with an error that contains the `entries` that failed to only retry those.
+module.exports = ({ size = Infinity, interval, flush }) => {
+
+	let values = new Map()
+	let timer
+	let pending = Promise.resolve()
+
+	// Batches that are waiting for their flush or are being flushed
+	const batches = new Set()
+
+	const schedule = () => {
+
+		if (timer != null) return
+
+		timer = setTimeout(run, interval)
+		// The buffer shouldn't keep the process alive
+		timer.unref()
+
+	}
+
+	// Newer values of the same keys replace the failed ones
+	const restore = (batch, err) => {
+
+		const failedEntries = Array.isArray(err.entries) === true ? err.entries : [ ...batch.values() ]
+
+		batch.forEach((value, key) => {
+			if (failedEntries.includes(value) === true && values.has(key) === false) values.set(key, value)
+		})
+
+		signale.warn(`Failed to flush ${ failedEntries.length } buffered entries, retrying: ${ err.message }`)
+
+		if (values.size > 0) schedule()
+
+	}
+
+	const run = () => {
+
+		clearTimeout(timer)
+		timer = undefined
+
+		if (values.size === 0) return pending
+
+		const batch = values
+		values = new Map()
+
+		// Values stay readable until they've been written
+		batches.add(batch)
+
+		// Flushes run one after another so a slow flush can't be overtaken by the next one
+		pending = pending
+			.then(() => flush([ ...batch.values() ]))
+			.catch((err) => restore(batch, err))
+			.then(() => {
+				batches.delete(batch)
+			})
+
+		return pending
+
+	}
+
+	const set = (key, value) => {
+
+		values.set(key, value)
+
+		if (values.size >= size) return run()
+
+		schedule()
+
+		return pending
+
+	}
+
+	// Flushes until all values have been written or all attempts failed. Returns the number of values that are left.
+	const drain = async (attempts = 3) => {
+
+		for (let attempt = 0; attempt < attempts; attempt++) {
+			await run()
+			if (values.size === 0) return 0
+		}
+
+		return values.size
+
+	}
+
+	// Latest value of each key, including the ones that are being written
+	const all = () => {
+
+		const latest = new Map()
+
+		batches.forEach((batch) => batch.forEach((value, key) => latest.set(key, value)))
+		values.forEach((value, key) => latest.set(key, value))
+
+		return latest
+
+	}
+
+	return {
+		get: (key) => values.get(key),
+		has: (key) => values.has(key),
+		values: () => values.values(),
+		size: () => values.size,
+		// Values that are being written must not be changed, but can be read until they've been written
+		all: () => all().values(),
+		isFlushing: (key) => values.has(key) === false && [ ...batches ].some((batch) => batch.has(key)),
+		// Resolves once all started flushes have been written or buffered again
+		settled: () => pending,
+		set,
+		flush: run,
+		drain
+	}
+
+}
@@ -0,0 +1,63 @@
+'use strict'
+
+// In-memory cache that drops the least recently used entry once it holds more than `max` entries.
+// Entries expire `ttl` ms after they have been set.
+module.exports = ({ max = Infinity, ttl = Infinity } = {}) => {
+
+	const entries = new Map()
+
+	const isExpired = (entry) => Date.now() - entry.created >= ttl
+
+	const get = (key) => {
+
+		const entry = entries.get(key)
+
+		if (entry == null) return undefined
+
+		if (isExpired(entry) === true) {
+			entries.delete(key)
+			return undefined
+		}
+
+		// Reinsert the entry to mark it as the most recently used one
+		entries.delete(key)
+		entries.set(key, entry)
+
+		return entry.value
+
+	}
+
+	const set = (key, value) => {
+
+		entries.delete(key)
+		entries.set(key, {
+			value,
+			created: Date.now()
+		})
+
+		// Maps iterate in insertion order, so the first key is the least recently used one
+		if (entries.size > max) entries.delete(entries.keys().next().value)
+
+	}
+
+	const del = (key) => {
+
+		entries.delete(key)
+
+	}
+
+	const clear = () => {
+
+		entries.clear()
+
+	}
+
+	return {
+		get,
+		set,
+		del,
+		clear,
+		size: () => entries.size
+	}
+
+}
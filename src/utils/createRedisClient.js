@@ -0,0 +1,151 @@
+'use strict'
+
+const net = require('net')
+
+const encode = (args) => {
+
+	const parts = args.map((arg) => {
+		const value = String(arg)
+		return `$${ Buffer.byteLength(value) }\r\n${ value }\r\n`
+	})
+
+	return `*${ args.length }\r\n${ parts.join('') }`
+
+}
+
+// Parses one RESP reply starting at offset. Returns undefined when the reply is incomplete.
+const parse = (buffer, offset) => {
+
+	const lineEnd = buffer.indexOf('\r\n', offset)
+
+	if (lineEnd === -1) return undefined
+
+	const type = String.fromCharCode(buffer[offset])
+	const line = buffer.toString('utf8', offset + 1, lineEnd)
+	const next = lineEnd + 2
+
+	switch (type) {
+		case '+': return { value: line, next }
+		case '-': return { value: new Error(line), next }
+		case ':': return { value: Number.parseInt(line), next }
+		case '$': {
+			const length = Number.parseInt(line)
+			if (length === -1) return { value: null, next }
+			if (buffer.length < next + length + 2) return undefined
+			return { value: buffer.toString('utf8', next, next + length), next: next + length + 2 }
+		}
+		case '*': {
+			const length = Number.parseInt(line)
+			if (length === -1) return { value: null, next }
+			const values = []
+			let current = next
+			for (let i = 0; i < length; i++) {
+				const reply = parse(buffer, current)
+				if (reply == null) return undefined
+				values.push(reply.value)
+				current = reply.next
+			}
+			return { value: values, next: current }
+		}
+		default: throw new Error(`Unknown Redis reply type \`${ type }\``)
+	}
+
+}
+
+// Minimal Redis client for the few commands Ackee needs. Commands are pipelined over
+// a single connection that gets established when the first command is sent.
+module.exports = (url) => {
+
+	const { hostname, port, password, pathname } = new URL(url)
+	const database = pathname.substr(1)
+
+	let socket
+	let buffer = Buffer.alloc(0)
+	let pending = []
+
+	// Replies of the failed connection must not reach commands of the next one, so it's closed
+	const fail = (err) => {
+
+		if (socket != null) {
+			socket.destroy()
+			socket = undefined
+		}
+
+		pending.forEach(({ reject }) => reject(err))
+		pending = []
+		buffer = Buffer.alloc(0)
+
+	}
+
+	const receive = (data) => {
+
+		buffer = Buffer.concat([ buffer, data ])
+
+		let reply = parse(buffer, 0)
+
+		while (reply != null) {
+
+			const entry = pending.shift()
+
+			// Commands of the reply have already been rejected
+			if (entry != null) {
+				if (reply.value instanceof Error) entry.reject(reply.value)
+				else entry.resolve(reply.value)
+			}
+
+			buffer = buffer.slice(reply.next)
+			reply = parse(buffer, 0)
+
+		}
+
+	}
+
+	const send = (args) => new Promise((resolve, reject) => {
+
+		pending.push({ resolve, reject })
+		socket.write(encode(args))
+
+	})
+
+	const connect = () => {
+
+		const current = net.createConnection(Number.parseInt(port) || 6379, hostname)
+
+		// Events of previous connections don't affect the current one
+		const isCurrent = () => socket === current
+
+		socket = current
+		socket.setNoDelay(true)
+		socket.on('data', (data) => isCurrent() === true && receive(data))
+		socket.on('error', (err) => isCurrent() === true && fail(err))
+		socket.on('close', () => isCurrent() === true && fail(new Error('Redis connection closed')))
+
+		// Sent before any other command, so no need to wait for the replies
+		if (password !== '') send([ 'AUTH', decodeURIComponent(password) ]).catch(fail)
+		if (database !== '') send([ 'SELECT', database ]).catch(fail)
+
+	}
+
+	const command = (...args) => {
+
+		if (socket == null) connect()
+
+		return send(args)
+
+	}
+
+	const quit = async () => {
+
+		if (socket == null) return
+
+		await send([ 'QUIT' ])
+		socket.end()
+
+	}
+
+	return {
+		command,
+		quit
+	}
+
+}
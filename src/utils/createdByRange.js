@@ -0,0 +1,21 @@
+'use strict'
+
+const offsetByRange = require('./offsetByRange')
+const startOfDayKey = require('./startOfDayKey')
+const dayIndex = require('./dayIndex')
+
+// Returns the condition of `created` for records of a range. Ranges without a start don't need one.
+module.exports = (range) => {
+
+	if (range != null && typeof range === 'object') {
+		return {
+			$gte: startOfDayKey(range.from),
+			$lt: startOfDayKey(dayIndex.toDayKey(dayIndex(range.to) + 1))
+		}
+	}
+
+	const dateOffset = offsetByRange(range)
+
+	return dateOffset == null ? undefined : { $gte: dateOffset }
+
+}
@@ -0,0 +1,16 @@
+'use strict'
+
+// Returns a line of CSV. Values with separators, quotes or line breaks are quoted.
+module.exports = (values) => {
+
+	return values.map((value) => {
+
+		if (value == null) return ''
+
+		const str = value instanceof Date ? value.toISOString() : String(value)
+
+		return /[",\r\n]/.test(str) === true ? `"${ str.replace(/"/g, '""') }"` : str
+
+	}).join(',') + '\n'
+
+}
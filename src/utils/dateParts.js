@@ -0,0 +1,48 @@
+'use strict'
+
+const defaultTimeZone = require('./timeZone')
+
+const formatters = new Map()
+
+const getFormatter = (timeZone) => {
+
+	if (formatters.has(timeZone) === false) formatters.set(timeZone, new Intl.DateTimeFormat('en-US', {
+		timeZone,
+		hour12: false,
+		year: 'numeric',
+		month: 'numeric',
+		day: 'numeric',
+		hour: 'numeric',
+		minute: 'numeric'
+	}))
+
+	return formatters.get(timeZone)
+
+}
+
+// Returns the calendar date and time of a date in a time zone. Throws for unknown time zones.
+module.exports = (date = new Date(), timeZone = defaultTimeZone) => {
+
+	if (timeZone === 'UTC') return {
+		year: date.getUTCFullYear(),
+		month: date.getUTCMonth() + 1,
+		day: date.getUTCDate(),
+		hour: date.getUTCHours(),
+		minute: date.getUTCMinutes()
+	}
+
+	const parts = getFormatter(timeZone).formatToParts(date).reduce((acc, part) => {
+		if (part.type !== 'literal') acc[part.type] = Number.parseInt(part.value)
+		return acc
+	}, {})
+
+	return {
+		year: parts.year,
+		month: parts.month,
+		day: parts.day,
+		// Some versions of ICU format midnight as 24
+		hour: parts.hour % 24,
+		minute: parts.minute
+	}
+
+}
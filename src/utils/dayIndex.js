@@ -0,0 +1,19 @@
+'use strict'
+
+const { day } = require('./times')
+
+// Returns the number of calendar days between 1970-01-01 and a day in the format yyyymmdd
+module.exports = (key) => {
+
+	return Math.round(Date.UTC(Math.floor(key / 10000), Math.floor(key / 100) % 100 - 1, key % 100) / day)
+
+}
+
+// Returns the day in the format yyyymmdd of a number of calendar days since 1970-01-01
+module.exports.toDayKey = (index) => {
+
+	const date = new Date(index * day)
+
+	return date.getUTCFullYear() * 10000 + (date.getUTCMonth() + 1) * 100 + date.getUTCDate()
+
+}
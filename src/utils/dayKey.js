@@ -0,0 +1,12 @@
+'use strict'
+
+const dateParts = require('./dateParts')
+
+// Returns the day of a date in the reporting time zone as an integer in the format yyyymmdd
+module.exports = (date = new Date(), timeZone) => {
+
+	const { year, month, day } = dateParts(date, timeZone)
+
+	return year * 10000 + month * 100 + day
+
+}
@@ -0,0 +1,20 @@
+'use strict'
+
+const timeZone = require('./timeZone')
+
+// Aggregation expression of the day of a record. Uses the day stored with the record and
+// falls back to its creation date for records that have been added before days were stored.
+module.exports = () => ({
+	$ifNull: [
+		'$day',
+		{
+			$toInt: {
+				$dateToString: {
+					format: '%Y%m%d',
+					date: '$created',
+					timezone: timeZone
+				}
+			}
+		}
+	]
+})
@@ -0,0 +1,19 @@
+'use strict'
+
+const offsetByRange = require('./offsetByRange')
+const dayKey = require('./dayKey')
+
+// Returns the first and the last day of a range in the format yyyymmdd. Custom
+// ranges already contain their days.
+module.exports = (range) => {
+
+	if (range != null && typeof range === 'object') return range
+
+	const dateOffset = offsetByRange(range)
+
+	return {
+		from: dateOffset == null ? 19700101 : dayKey(dateOffset),
+		to: dayKey()
+	}
+
+}
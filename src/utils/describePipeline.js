@@ -0,0 +1,13 @@
+'use strict'
+
+// Names an aggregation by its stages and the fields of its first match,
+// e.g. `$match(domainId,created) $group $sort $limit`. Values are omitted to keep the number of names small.
+module.exports = (pipeline) => pipeline.map((stage) => {
+
+	const operator = Object.keys(stage)[0]
+
+	if (operator === '$match') return `$match(${ Object.keys(stage.$match).join(',') })`
+
+	return operator
+
+}).join(' ')
@@ -0,0 +1,13 @@
+'use strict'
+
+const constants = require('../constants/durations')
+
+// Returns the histogram bucket of a duration. Durations are rounded down to the
+// tracking interval and everything above the limit shares the last bucket.
+module.exports = (created, updated) => {
+
+	const bucket = Math.floor((updated - created) / constants.DURATIONS_INTERVAL)
+
+	return Math.max(0, Math.min(bucket, constants.DURATIONS_LIMIT / constants.DURATIONS_INTERVAL))
+
+}
@@ -0,0 +1,41 @@
+'use strict'
+
+// A block of level n contains 2^n consecutive days and starts at a multiple of 2^n.
+// Blocks of the highest level contain 1024 days.
+const maxLevel = 10
+
+// Covers the days between two day indexes (both included) with the smallest number of
+// blocks. Any range needs at most two blocks per level and one per 1024 days beyond.
+module.exports = (from, to) => {
+
+	const blocks = []
+
+	let start = from
+
+	while (start <= to) {
+
+		let level = 0
+
+		while (level < maxLevel && start % 2 ** (level + 1) === 0 && start + 2 ** (level + 1) - 1 <= to) level++
+
+		blocks.push({ level, start })
+		start += 2 ** level
+
+	}
+
+	return blocks
+
+}
+
+// Returns the blocks above the level of single days that contain a day index
+module.exports.containing = (index) => {
+
+	const blocks = []
+
+	for (let level = 1; level <= maxLevel; level++) {
+		blocks.push({ level, start: index - index % 2 ** level })
+	}
+
+	return blocks
+
+}
@@ -0,0 +1,46 @@
+'use strict'
+
+// Walks all objects of an explain result
+const walk = (value, fn) => {
+
+	if (value == null || typeof value !== 'object') return
+
+	fn(value)
+
+	Object.values(value).forEach((child) => walk(child, fn))
+
+}
+
+// Summarizes the output of an aggregation explained with `executionStats`. The shape of
+// the output depends on the MongoDB version and on how much of the pipeline runs in the query layer.
+module.exports = (explain) => {
+
+	const stats = {
+		docsExamined: 0,
+		keysExamined: 0,
+		indexes: [],
+		collectionScan: false,
+		usedDisk: false
+	}
+
+	walk(explain, (value) => {
+
+		if (value.executionStats != null && typeof value.executionStats.totalDocsExamined === 'number') {
+			stats.docsExamined += value.executionStats.totalDocsExamined
+			stats.keysExamined += value.executionStats.totalKeysExamined
+		}
+
+		if (value.winningPlan != null) {
+			walk(value.winningPlan, (stage) => {
+				if (stage.stage === 'IXSCAN' && stats.indexes.includes(stage.indexName) === false) stats.indexes.push(stage.indexName)
+				if (stage.stage === 'COLLSCAN') stats.collectionScan = true
+			})
+		}
+
+		if (value.usedDisk === true) stats.usedDisk = true
+
+	})
+
+	return stats
+
+}
@@ -303,4 +303,8 @@ module.exports = (url) => {
 
 	return schedule.scheduleJob(rule, job(url))
 
-}
\ No newline at end of file
+}
+
+// Used to generate load without the schedule
+module.exports.createRecord = createRecord
+module.exports.addToken = addToken
\ No newline at end of file
@@ -0,0 +1,54 @@
+'use strict'
+
+// HyperLogLog with 2^12 registers. The standard error is about 1.6 %.
+const PRECISION = 12
+const SIZE = 2 ** PRECISION
+
+// Returns the register and its rank of a hex encoded hash. The first 12 bits select the
+// register. The rank is the position of the first set bit in the remaining bits.
+const register = (hash) => {
+
+	const index = Number.parseInt(hash.slice(0, PRECISION / 4), 16)
+	let rank = 1
+
+	for (const char of hash.slice(PRECISION / 4)) {
+
+		const value = Number.parseInt(char, 16)
+
+		if (value === 0) {
+			rank += 4
+			continue
+		}
+
+		rank += Math.clz32(value) - 28
+		break
+
+	}
+
+	return {
+		index,
+		rank
+	}
+
+}
+
+// Estimates the number of distinct hashes from the sum of 2^-rank of all set registers
+// and the number of set registers. Uses linear counting for small cardinalities.
+const estimate = (sum, registers) => {
+
+	const zeros = SIZE - registers
+	const alpha = 0.7213 / (1 + 1.079 / SIZE)
+	const raw = alpha * SIZE * SIZE / (sum + zeros)
+
+	if (raw <= 2.5 * SIZE && zeros > 0) return Math.round(SIZE * Math.log(SIZE / zeros))
+
+	return Math.round(raw)
+
+}
+
+module.exports = {
+	PRECISION,
+	SIZE,
+	register,
+	estimate
+}
@@ -5,11 +5,35 @@ const { getClientIp } = require('request-ip')
 
 const salt = require('./salt')
 
+// Hash state after the salt, which only changes once a day
+let saltedHash
+
+const createHash = () => {
+
+	const currentSalt = salt()
+
+	// Copying hashes requires Node.js 13
+	if (typeof crypto.Hash.prototype.copy !== 'function') return crypto.createHash('sha256').update(currentSalt)
+
+	if (saltedHash == null || saltedHash.salt !== currentSalt) saltedHash = {
+		salt: currentSalt,
+		hash: crypto.createHash('sha256').update(currentSalt)
+	}
+
+	return saltedHash.hash.copy()
+
+}
+
+// Hashing the parts one by one is the same as hashing them concatenated, without building the string
 module.exports = (req, domainId) => {
 
 	const ip = getClientIp(req)
 	const userAgent = req.headers['user-agent']
 
-	return crypto.createHash('sha256').update(`${ salt() }${ ip }${ userAgent }${ domainId }`).digest('hex')
+	return createHash()
+		.update(String(ip))
+		.update(String(userAgent))
+		.update(String(domainId))
+		.digest('hex')
 
-}
\ No newline at end of file
+}
@@ -0,0 +1,22 @@
+'use strict'
+
+const constants = require('../constants/views')
+const dayKey = require('./dayKey')
+const dayIndex = require('./dayIndex')
+
+// Returns the first day (yyyymmdd) of the latest days, months or years including the current one
+module.exports = (interval, length, today = dayKey()) => {
+
+	const year = Math.floor(today / 10000)
+	const month = Math.floor(today / 100) % 100
+
+	switch (interval) {
+		case constants.VIEWS_INTERVAL_DAILY: return dayIndex.toDayKey(dayIndex(today) - length + 1)
+		case constants.VIEWS_INTERVAL_MONTHLY: {
+			const months = year * 12 + month - 1 - length + 1
+			return Math.floor(months / 12) * 10000 + (months % 12 + 1) * 100 + 1
+		}
+		case constants.VIEWS_INTERVAL_YEARLY: return (year - length + 1) * 10000 + 101
+	}
+
+}
\ No newline at end of file
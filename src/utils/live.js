@@ -0,0 +1,120 @@
+'use strict'
+
+const cluster = require('cluster')
+const { EventEmitter } = require('events')
+
+const MESSAGE_TYPE = 'ackee:live'
+const LISTENERS_MESSAGE_TYPE = 'ackee:live:listeners'
+const WATCHED_MESSAGE_TYPE = 'ackee:live:watched'
+
+const emitter = new EventEmitter()
+
+// Every connected dashboard listens to each of its domains
+emitter.setMaxListeners(0)
+
+// Domains with listeners in any process. Deltas of other domains aren't sent at all.
+let watchedDomains = new Set()
+
+// Domains with listeners of each worker. Only known to the primary.
+const workerDomains = new Map()
+
+const emit = (message) => emitter.emit(message.domainId, message.delta)
+
+const localDomains = () => emitter.eventNames().filter((domainId) => emitter.listenerCount(domainId) > 0)
+
+const isWatched = (domainId) => emitter.listenerCount(domainId) > 0 || watchedDomains.has(domainId)
+
+// Records can be added by any worker while a dashboard is connected to another one.
+// The primary forwards the deltas to the workers that listen to the domain.
+const forward = (message) => {
+
+	emit(message)
+
+	Object.values(cluster.workers).forEach((worker) => {
+		const domains = workerDomains.get(worker.id)
+		if (domains == null || domains.has(message.domainId) === false) return
+		if (worker.isConnected() === true) worker.send(message)
+	})
+
+}
+
+// Tells all workers which domains are watched in any of them
+const broadcast = () => {
+
+	const domainIds = new Set()
+	workerDomains.forEach((domains) => domains.forEach((domainId) => domainIds.add(domainId)))
+
+	watchedDomains = domainIds
+
+	Object.values(cluster.workers).forEach((worker) => {
+		if (worker.isConnected() === true) worker.send({ type: WATCHED_MESSAGE_TYPE, domainIds: [ ...domainIds ] })
+	})
+
+}
+
+if (cluster.isMaster === true) {
+
+	cluster.on('message', (worker, message) => {
+		if (message == null) return
+		if (message.type === MESSAGE_TYPE) forward(message)
+		if (message.type === LISTENERS_MESSAGE_TYPE) {
+			workerDomains.set(worker.id, new Set(message.domainIds))
+			broadcast()
+		}
+	})
+
+	cluster.on('exit', (worker) => {
+		if (workerDomains.delete(worker.id) === true) broadcast()
+	})
+
+} else {
+
+	process.on('message', (message) => {
+		if (message == null) return
+		if (message.type === MESSAGE_TYPE) emit(message)
+		if (message.type === WATCHED_MESSAGE_TYPE) watchedDomains = new Set(message.domainIds)
+	})
+
+}
+
+// Workers report their domains to the primary whenever their listeners change
+const report = () => {
+
+	if (cluster.isMaster === true) return
+
+	process.send({ type: LISTENERS_MESSAGE_TYPE, domainIds: localDomains() })
+
+}
+
+// Notifies the live dashboards of a domain about a change of its data
+const publish = (domainId, delta) => {
+
+	if (isWatched(domainId) === false) return
+
+	const message = { type: MESSAGE_TYPE, domainId, delta }
+
+	if (cluster.isMaster === true) return forward(message)
+
+	process.send(message)
+
+}
+
+// Calls fn with the deltas of all given domains. Returns a function that removes the listeners.
+const subscribe = (domainIds, fn) => {
+
+	const listeners = domainIds.map((domainId) => [ domainId, (delta) => fn(domainId, delta) ])
+
+	listeners.forEach(([ domainId, listener ]) => emitter.on(domainId, listener))
+	report()
+
+	return () => {
+		listeners.forEach(([ domainId, listener ]) => emitter.removeListener(domainId, listener))
+		report()
+	}
+
+}
+
+module.exports = {
+	publish,
+	subscribe
+}
@@ -0,0 +1,25 @@
+'use strict'
+
+// Maps all items with an async function, but runs at most `limit` calls at the same time.
+// The results keep the order of the items.
+module.exports = async (items, limit, fn) => {
+
+	const results = new Array(items.length)
+	let nextIndex = 0
+
+	const worker = async () => {
+
+		while (nextIndex < items.length) {
+			const index = nextIndex++
+			results[index] = await fn(items[index], index)
+		}
+
+	}
+
+	const workerCount = Math.max(1, Math.min(limit, items.length))
+
+	await Promise.all(Array(workerCount).fill().map(worker))
+
+	return results
+
+}
@@ -0,0 +1,14 @@
+'use strict'
+
+// Returns the keys of all indexes that are declared in the schema of a model,
+// but don't exist in its collection. Indexes are compared by their key pattern.
+module.exports = async (model) => {
+
+	const indexes = await model.collection.indexes()
+	const existingKeys = indexes.map((index) => JSON.stringify(index.key))
+
+	return model.schema.indexes()
+		.map(([ key ]) => key)
+		.filter((key) => existingKeys.includes(JSON.stringify(key)) === false)
+
+}
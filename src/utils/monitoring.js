@@ -0,0 +1,206 @@
+'use strict'
+
+const cluster = require('cluster')
+
+const prometheus = require('./prometheus')
+const describePipeline = require('./describePipeline')
+
+const token = process.env.ACKEE_METRICS_TOKEN
+const enabled = token != null && token !== ''
+
+const MESSAGE_TYPE = 'ackee:metrics'
+
+// Maximum time to wait for the metrics of other processes
+const collectTimeout = 1000
+
+const registry = prometheus()
+const buckets = [ 0.005, 0.01, 0.025, 0.05, 0.1, 0.25, 0.5, 1, 2.5, 5, 10 ]
+
+const requestDuration = registry.histogram('ackee_http_request_duration_seconds', 'Duration of HTTP requests by route and status', buckets)
+const commandDuration = registry.histogram('ackee_mongodb_command_duration_seconds', 'Duration of MongoDB commands by collection and aggregation pipeline', buckets)
+
+const seconds = (start) => {
+
+	const [ s, ns ] = process.hrtime(start)
+
+	return s + ns / 1e9
+
+}
+
+let eventLoopLag = 0
+
+if (enabled === true) {
+
+	// Timers fire late when the event loop is blocked
+	const interval = 500
+	let start = process.hrtime()
+
+	setInterval(() => {
+		eventLoopLag = Math.max(0, seconds(start) - interval / 1000)
+		start = process.hrtime()
+	}, interval).unref()
+
+	registry.gauge('ackee_event_loop_lag_seconds', 'Delay of the event loop in the last sample', () => eventLoopLag)
+	registry.gauge('ackee_process_heap_used_bytes', 'Used heap size', () => process.memoryUsage().heapUsed)
+	registry.gauge('ackee_process_heap_total_bytes', 'Total heap size', () => process.memoryUsage().heapTotal)
+	registry.gauge('ackee_process_resident_memory_bytes', 'Resident memory size', () => process.memoryUsage().rss)
+	registry.gauge('ackee_process_cpu_seconds', 'User and system CPU time of the process since it started', () => {
+		const { user, system } = process.cpuUsage()
+		return (user + system) / 1e6
+	})
+
+}
+
+// Wraps a route handler to measure its requests. Uses the path of the route instead of
+// the URL so that ids don't create a new series per request.
+const observe = (route, fn) => enabled === false ? fn : (req, res) => {
+
+	const start = process.hrtime()
+
+	// Errors are sent outside of the handler, so the status is read once the response is complete
+	res.once('finish', () => {
+		requestDuration.observe({ method: req.method, route, status: res.statusCode }, seconds(start))
+	})
+
+	return fn(req, res)
+
+}
+
+// Measures all commands of a client with the command monitoring of the driver.
+// Requires the client to be connected with `monitorCommands`.
+const watch = (client) => {
+
+	if (enabled === false) return
+
+	const pending = new Map()
+
+	client.on('commandStarted', (event) => {
+
+		// Cursors of long results are read with getMore, which names the collection separately
+		const collection = event.commandName === 'getMore' ? event.command.collection : event.command[event.commandName]
+		const pipeline = event.commandName === 'aggregate' ? describePipeline(event.command.pipeline || []) : ''
+
+		pending.set(event.requestId, {
+			command: event.commandName,
+			collection: typeof collection === 'string' ? collection : '',
+			pipeline
+		})
+
+	})
+
+	const finish = (event) => {
+
+		const labels = pending.get(event.requestId)
+
+		if (labels == null) return
+
+		pending.delete(event.requestId)
+		commandDuration.observe(labels, event.duration / 1000)
+
+	}
+
+	client.on('commandSucceeded', finish)
+	client.on('commandFailed', finish)
+
+}
+
+// Scrapes reach any worker of the cluster mode. The worker asks the primary to collect the
+// metrics of all processes, which are labeled with their worker to keep their series apart.
+const gathers = new Map()
+const requests = new Map()
+let requestCount = 0
+
+if (enabled === true && cluster.isMaster === true) {
+
+	cluster.on('message', (worker, message) => {
+
+		if (message == null || message.type !== MESSAGE_TYPE) return
+
+		if (message.action === 'gather') {
+
+			const workers = Object.values(cluster.workers).filter((entry) => entry.isConnected() === true)
+
+			const gather = {
+				collections: [ registry.collect({ worker: 'primary' }) ],
+				remaining: workers.length,
+				finish: () => {
+					clearTimeout(gather.timer)
+					gathers.delete(message.id)
+					if (worker.isConnected() === true) worker.send({ type: MESSAGE_TYPE, action: 'gathered', id: message.id, collections: gather.collections })
+				}
+			}
+
+			// Workers that don't answer in time are left out
+			gather.timer = setTimeout(gather.finish, collectTimeout)
+			gathers.set(message.id, gather)
+
+			if (workers.length === 0) return gather.finish()
+
+			workers.forEach((entry) => entry.send({ type: MESSAGE_TYPE, action: 'collect', id: message.id }))
+
+		}
+
+		if (message.action === 'collected') {
+
+			const gather = gathers.get(message.id)
+
+			if (gather == null) return
+
+			gather.collections.push(message.metrics)
+			if (--gather.remaining === 0) gather.finish()
+
+		}
+
+	})
+
+}
+
+if (enabled === true && cluster.isWorker === true) {
+
+	process.on('message', (message) => {
+
+		if (message == null || message.type !== MESSAGE_TYPE) return
+
+		if (message.action === 'collect') {
+			process.send({ type: MESSAGE_TYPE, action: 'collected', id: message.id, metrics: registry.collect({ worker: cluster.worker.id }) })
+		}
+
+		if (message.action === 'gathered' && requests.has(message.id) === true) {
+			requests.get(message.id)(message.collections)
+		}
+
+	})
+
+}
+
+// Returns the metrics of the current process or of all processes of the cluster mode
+const render = () => new Promise((resolve) => {
+
+	if (cluster.isWorker === false) return resolve(registry.render())
+
+	const id = `${ process.pid }:${ ++requestCount }`
+
+	// The primary might not answer, e.g. while it's shutting down
+	const timer = setTimeout(() => {
+		requests.delete(id)
+		resolve(prometheus.render([ registry.collect({ worker: cluster.worker.id }) ]))
+	}, collectTimeout * 2)
+
+	requests.set(id, (collections) => {
+		clearTimeout(timer)
+		requests.delete(id)
+		resolve(prometheus.render(collections))
+	})
+
+	process.send({ type: MESSAGE_TYPE, action: 'gather', id })
+
+})
+
+module.exports = {
+	enabled,
+	token,
+	registry,
+	render,
+	observe,
+	watch
+}
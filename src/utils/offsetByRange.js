@@ -1,19 +1,22 @@
 'use strict'
 
-const { subDays } = require('date-fns')
-
-const zeroDate = require('./zeroDate')
+const dayKey = require('./dayKey')
+const dayIndex = require('./dayIndex')
+const startOfDayKey = require('./startOfDayKey')
 const ranges = require('../constants/ranges')
 
+// Ranges start at midnight of the reporting time zone, like the days of the rollups
+const daysAgo = (days) => startOfDayKey(dayIndex.toDayKey(dayIndex(dayKey()) - days))
+
 module.exports = (range) => {
 
 	switch (range) {
 		case ranges.RANGES_LAST_24_HOURS:
-			return subDays(zeroDate(), 1)
+			return daysAgo(1)
 		case ranges.RANGES_LAST_7_DAYS:
-			return subDays(zeroDate(), 6)
+			return daysAgo(6)
 		case ranges.RANGES_LAST_30_DAYS:
-			return subDays(zeroDate(), 29)
+			return daysAgo(29)
 		default:
 			return null
 	}
@@ -0,0 +1,12 @@
+'use strict'
+
+// Parses command line options in the format `--name=value`. Options without value are true.
+module.exports = (argv) => argv.reduce((acc, arg) => {
+
+	const [ key, ...value ] = arg.replace(/^--/, '').split('=')
+
+	acc[key] = value.length === 0 ? true : value.join('=')
+
+	return acc
+
+}, {})
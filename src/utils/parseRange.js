@@ -0,0 +1,34 @@
+'use strict'
+
+const dayKey = require('./dayKey')
+
+const parseDate = (value) => {
+
+	const date = new Date(/^\d+$/.test(value) === true ? Number.parseInt(value) : value)
+
+	return Number.isNaN(date.getTime()) === true ? undefined : date
+
+}
+
+// Returns the days of a custom range between the `from` and `to` parameters (both included)
+// in the format yyyymmdd. `to` defaults to today. Returns undefined without a custom range
+// and null when it's invalid.
+module.exports = (from, to) => {
+
+	if (from == null && to == null) return
+
+	if (from == null) return null
+
+	const fromDate = parseDate(from)
+	const toDate = to == null ? new Date() : parseDate(to)
+
+	if (fromDate == null || toDate == null) return null
+
+	const range = {
+		from: dayKey(fromDate),
+		to: dayKey(toDate)
+	}
+
+	return range.from <= range.to ? range : null
+
+}
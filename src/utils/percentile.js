@@ -0,0 +1,12 @@
+'use strict'
+
+// Returns the p-th percentile (0-100) of sorted values with the nearest-rank method
+module.exports = (sortedValues, p) => {
+
+	if (sortedValues.length === 0) return null
+
+	const rank = Math.ceil(p / 100 * sortedValues.length)
+
+	return sortedValues[Math.min(Math.max(rank, 1), sortedValues.length) - 1]
+
+}
@@ -0,0 +1,26 @@
+'use strict'
+
+const constants = require('../constants/views')
+
+const day = {
+	$mod: [ '$day', 100 ]
+}
+
+const month = {
+	$mod: [ { $floor: { $divide: [ '$day', 100 ] } }, 100 ]
+}
+
+const year = {
+	$floor: { $divide: [ '$day', 10000 ] }
+}
+
+// Aggregation expression of the day, month or year of a rollup. Days are stored as yyyymmdd.
+module.exports = (interval) => {
+
+	switch (interval) {
+		case constants.VIEWS_INTERVAL_DAILY: return { day, month, year }
+		case constants.VIEWS_INTERVAL_MONTHLY: return { month, year }
+		case constants.VIEWS_INTERVAL_YEARLY: return { year }
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,128 @@
+'use strict'
+
+const escape = (value) => String(value).replace(/\\/g, '\\\\').replace(/\n/g, '\\n').replace(/"/g, '\\"')
+
+const formatLabels = (labels) => {
+
+	const keys = Object.keys(labels)
+
+	if (keys.length === 0) return ''
+
+	return `{${ keys.map((key) => `${ key }="${ escape(labels[key]) }"`).join(',') }}`
+
+}
+
+// Returns the entry of a label combination. Labels must always be passed in the same order.
+const entryOf = (entries, labels, create) => {
+
+	const key = JSON.stringify(labels)
+
+	if (entries.has(key) === false) entries.set(key, create())
+
+	return entries.get(key)
+
+}
+
+const formatSample = (sample) => `${ sample.name }${ formatLabels(sample.labels) } ${ sample.value }`
+
+// Renders collected metrics in the text format of Prometheus. Samples of metrics with
+// the same name are merged, e.g. when they've been collected from multiple processes.
+const render = (collections) => {
+
+	const metrics = new Map()
+
+	collections.forEach((collection) => collection.forEach((metric) => {
+		const entry = metrics.get(metric.name) || { ...metric, samples: [] }
+		entry.samples = [ ...entry.samples, ...metric.samples ]
+		metrics.set(metric.name, entry)
+	}))
+
+	return [ ...metrics.values() ].map((metric) => [
+		`# HELP ${ metric.name } ${ metric.help }`,
+		`# TYPE ${ metric.name } ${ metric.type }`,
+		...metric.samples.map(formatSample)
+	].join('\n')).join('\n') + '\n'
+
+}
+
+// Minimal registry of metrics that can be rendered in the text format of Prometheus
+module.exports = () => {
+
+	const metrics = []
+
+	const add = (name, help, type, samples) => metrics.push({ name, help, type, samples })
+
+	const counter = (name, help) => {
+
+		const entries = new Map()
+
+		add(name, help, 'counter', () => [ ...entries.values() ].map((entry) => ({ name, labels: entry.labels, value: entry.value })))
+
+		return {
+			inc: (labels = {}, value = 1) => entryOf(entries, labels, () => ({ labels, value: 0 })).value += value
+		}
+
+	}
+
+	// The values of gauges are collected when the metrics are rendered
+	const gauge = (name, help, collect) => {
+
+		add(name, help, 'gauge', () => {
+
+			const values = collect()
+			const entries = Array.isArray(values) === true ? values : [ { labels: {}, value: values } ]
+
+			return entries.map((entry) => ({ name, labels: entry.labels, value: entry.value }))
+
+		})
+
+	}
+
+	const histogram = (name, help, buckets) => {
+
+		const entries = new Map()
+
+		add(name, help, 'histogram', () => [ ...entries.values() ].reduce((acc, entry) => [
+			...acc,
+			...buckets.map((bucket, index) => ({ name: `${ name }_bucket`, labels: { ...entry.labels, le: bucket }, value: entry.counts[index] })),
+			{ name: `${ name }_bucket`, labels: { ...entry.labels, le: '+Inf' }, value: entry.count },
+			{ name: `${ name }_sum`, labels: entry.labels, value: entry.sum },
+			{ name: `${ name }_count`, labels: entry.labels, value: entry.count }
+		], []))
+
+		return {
+			observe: (labels, value) => {
+
+				const entry = entryOf(entries, labels, () => ({ labels, counts: buckets.map(() => 0), sum: 0, count: 0 }))
+
+				buckets.forEach((bucket, index) => {
+					if (value <= bucket) entry.counts[index]++
+				})
+
+				entry.sum += value
+				entry.count++
+
+			}
+		}
+
+	}
+
+	// Returns the current samples of all metrics. The given labels are added to each sample.
+	const collect = (labels = {}) => metrics.map((metric) => ({
+		name: metric.name,
+		help: metric.help,
+		type: metric.type,
+		samples: metric.samples().map((sample) => ({ ...sample, labels: { ...labels, ...sample.labels } }))
+	}))
+
+	return {
+		counter,
+		gauge,
+		histogram,
+		collect,
+		render: () => render([ collect() ])
+	}
+
+}
+
+module.exports.render = render
\ No newline at end of file
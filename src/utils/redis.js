@@ -0,0 +1,6 @@
+'use strict'
+
+const createRedisClient = require('./createRedisClient')
+
+// Shared Redis connection. Optional and only available when configured.
+module.exports = process.env.ACKEE_REDIS == null ? undefined : createRedisClient(process.env.ACKEE_REDIS)
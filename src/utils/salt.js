@@ -1,15 +1,46 @@
 'use strict'
 
 const crypto = require('crypto')
+const cluster = require('cluster')
 const schedule = require('node-schedule')
 
+const timeZone = require('./timeZone')
+
+const MESSAGE_TYPE = 'ackee:salt'
+
 const generate = () => crypto.randomBytes(16).toString('hex')
 let salt = generate()
 
-// Generate a new salt every day
-const rule = new schedule.RecurrenceRule()
-rule.hour = 0
+// Workers receive the salt of the primary to hash visitors the same way.
+// The salt is only shared between processes and never stored.
+const broadcast = (worker) => worker.send({ type: MESSAGE_TYPE, salt })
+
+const ready = cluster.isMaster === true ? Promise.resolve() : new Promise((resolve) => {
+
+	process.on('message', (message) => {
+		if (message == null || message.type !== MESSAGE_TYPE) return
+		salt = message.salt
+		resolve()
+	})
+
+})
+
+if (cluster.isMaster === true) {
+
+	// Generate a new salt at the start of every day of the reporting time zone
+	const rule = new schedule.RecurrenceRule()
+	rule.hour = 0
+	rule.minute = 0
+	rule.tz = timeZone
+
+	schedule.scheduleJob(rule, () => {
+		salt = generate()
+		Object.values(cluster.workers).forEach(broadcast)
+	})
+
+	cluster.on('online', broadcast)
 
-schedule.scheduleJob(rule, () => salt = generate())
+}
 
-module.exports = () => salt
\ No newline at end of file
+module.exports = () => salt
+module.exports.ready = () => ready
@@ -0,0 +1,22 @@
+'use strict'
+
+const accuracies = require('../constants/accuracies')
+
+const rate = Number.parseFloat(process.env.ACKEE_SAMPLE_RATE) || 0.05
+
+// Ids of records are random, so records can be sampled by their first four hex characters.
+// The same records are part of the sample on every request.
+const prefixes = 16 ** 4
+const limit = Math.min(prefixes, Math.max(1, Math.round(rate * prefixes)))
+
+// Returns the sample of approximate results. Results are exact without one.
+module.exports = (accuracy) => {
+
+	if (accuracy !== accuracies.ACCURACIES_APPROXIMATE || limit === prefixes) return
+
+	return {
+		threshold: limit.toString(16).padStart(4, '0'),
+		scale: prefixes / limit
+	}
+
+}
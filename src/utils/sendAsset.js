@@ -0,0 +1,52 @@
+'use strict'
+
+// Returns true when the client accepts the encoding and didn't disable it with q=0
+const accepts = (header, encoding) => {
+
+	return header.split(',').some((part) => {
+
+		const [ name, ...params ] = part.trim().split(';')
+		const quality = params.find((param) => param.trim().startsWith('q='))
+
+		return name === encoding && (quality == null || Number.parseFloat(quality.trim().slice(2)) > 0)
+
+	})
+
+}
+
+// Sends an asset of utils/createAsset in the best encoding the client accepts.
+// Each encoding has its own strong ETag so caches can't mix them up.
+module.exports = (req, res, asset, cacheControl) => {
+
+	const acceptEncoding = req.headers['accept-encoding'] || ''
+
+	const [ encoding, data ] = (() => {
+
+		if (asset.brotli != null && accepts(acceptEncoding, 'br') === true) return [ 'br', asset.brotli ]
+		if (asset.gzip != null && accepts(acceptEncoding, 'gzip') === true) return [ 'gzip', asset.gzip ]
+
+		return [ undefined, asset.content ]
+
+	})()
+
+	const etag = encoding == null ? `"${ asset.hash }"` : `"${ asset.hash }-${ encoding }"`
+
+	res.setHeader('Content-Type', asset.type)
+	res.setHeader('Cache-Control', cacheControl)
+	res.setHeader('Vary', 'Accept-Encoding')
+	res.setHeader('ETag', etag)
+
+	const ifNoneMatch = req.headers['if-none-match'] || ''
+	const isCached = ifNoneMatch.split(',').some((value) => value.trim() === etag)
+
+	if (isCached === true) {
+		res.statusCode = 304
+		return res.end()
+	}
+
+	if (encoding != null) res.setHeader('Content-Encoding', encoding)
+	res.setHeader('Content-Length', data.length)
+
+	res.end(data)
+
+}
@@ -0,0 +1,48 @@
+'use strict'
+
+// Merges counted values into a Space-Saving summary with at most `size` counters.
+// A new value replaces the smallest counter when the summary is full and inherits
+// its count as error. Negative counts remove values that are still tracked.
+module.exports = (counters, deltas, size) => {
+
+	const entries = new Map(counters.map((counter) => [ JSON.stringify(counter.value), { ...counter } ]))
+
+	// Larger deltas first so they can't be replaced by smaller ones of the same merge
+	const sortedDeltas = [ ...deltas ].sort((a, b) => b.count - a.count)
+
+	sortedDeltas.forEach((delta) => {
+
+		const key = JSON.stringify(delta.value)
+		const entry = entries.get(key)
+
+		if (entry != null) {
+			entry.count = Math.max(entry.count + delta.count, 0)
+			return
+		}
+
+		// Values that aren't tracked anymore have already been counted as error
+		if (delta.count <= 0) return
+
+		if (entries.size < size) {
+			entries.set(key, { value: delta.value, count: delta.count, error: 0 })
+			return
+		}
+
+		let minKey
+		let minEntry
+
+		entries.forEach((value, key) => {
+			if (minEntry == null || value.count < minEntry.count) {
+				minKey = key
+				minEntry = value
+			}
+		})
+
+		entries.delete(minKey)
+		entries.set(key, { value: delta.value, count: minEntry.count + delta.count, error: minEntry.count })
+
+	})
+
+	return [ ...entries.values() ].sort((a, b) => b.count - a.count)
+
+}
@@ -0,0 +1,17 @@
+'use strict'
+
+const dateParts = require('./dateParts')
+
+// Returns the start of the day of a date in the reporting time zone
+module.exports = (date = new Date(), timeZone) => {
+
+	const { year, month, day } = dateParts(date, timeZone)
+
+	// The offset of the time zone at midnight UTC of the same calendar day
+	const utc = Date.UTC(year, month - 1, day)
+	const local = dateParts(new Date(utc), timeZone)
+	const offset = Date.UTC(local.year, local.month - 1, local.day, local.hour, local.minute) - utc
+
+	return new Date(utc - offset)
+
+}
@@ -0,0 +1,9 @@
+'use strict'
+
+const startOfDay = require('./startOfDay')
+const dayIndex = require('./dayIndex')
+const { day } = require('./times')
+
+// Returns the start of a day in the format yyyymmdd in the reporting time zone.
+// Noon UTC of a calendar day is on the same day in almost all time zones.
+module.exports = (key, timeZone) => startOfDay(new Date(dayIndex(key) * day + day / 2), timeZone)
\ No newline at end of file
@@ -0,0 +1,43 @@
+'use strict'
+
+const enabled = process.env.ACKEE_TIME_SERIES === 'true'
+const granularity = process.env.ACKEE_TIME_SERIES_GRANULARITY || 'minutes'
+
+// Records and their heartbeats can be stored in time-series collections, which keep the
+// documents of a domain in compressed buckets. Documents are grouped by their domain.
+const options = (timeField) => ({
+	timeField,
+	metaField: 'domainId',
+	granularity
+})
+
+// Returns the type of the collection of a model or undefined when it doesn't exist
+const collectionType = async (Model) => {
+
+	const [ info ] = await Model.db.db.listCollections({ name: Model.collection.collectionName }).toArray()
+
+	return info == null ? undefined : info.type
+
+}
+
+// Inserts would create a regular collection, so the time-series collection and its indexes
+// must exist before the first document is added
+const create = async (Model, timeField) => {
+
+	const name = Model.collection.collectionName
+	const type = await collectionType(Model)
+
+	if (type == null) await Model.db.db.command({ create: name, timeseries: options(timeField) })
+	else if (type !== 'timeseries') throw new Error(`Collection \`${ name }\` isn't a time-series collection. Run \`yarn migrate\` to convert it`)
+
+	await Model.createIndexes()
+
+}
+
+module.exports = {
+	enabled,
+	granularity,
+	options,
+	collectionType,
+	create
+}
\ No newline at end of file
@@ -0,0 +1,4 @@
+'use strict'
+
+// Time zone of the days in rollups. Existing rollups keep their days until `yarn backfill` rebuilds them.
+module.exports = process.env.ACKEE_TIMEZONE || 'UTC'
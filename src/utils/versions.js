@@ -0,0 +1,53 @@
+'use strict'
+
+const crypto = require('crypto')
+
+const redis = require('./redis')
+
+const localVersions = new Map()
+
+// Local versions start at 0 again on every start and differ between processes.
+// Tags of them are only valid for the current process.
+const instance = redis == null ? crypto.randomBytes(8).toString('hex') : ''
+
+const key = (id) => `ackee:version:${ id }`
+
+// Returns the current version of the data of a domain. The version changes whenever new
+// data has been added. Versions are shared between processes when Redis is configured.
+const get = async (id) => {
+
+	if (redis == null) return localVersions.get(id) || 0
+
+	const version = await redis.command('GET', key(id))
+
+	return version == null ? 0 : Number.parseInt(version)
+
+}
+
+const bump = async (id) => {
+
+	if (redis == null) {
+		localVersions.set(id, (localVersions.get(id) || 0) + 1)
+		return
+	}
+
+	await redis.command('INCR', key(id))
+
+}
+
+// Returns a value that changes whenever one of the versions changes
+const tag = async (ids) => {
+
+	const values = await Promise.all(ids.map(get))
+
+	return JSON.stringify([ instance, ids, values ])
+
+}
+
+module.exports = {
+	// Versions of other processes can only be trusted when they're shared
+	shared: redis != null,
+	get,
+	bump,
+	tag
+}
@@ -1,14 +1,6 @@
 'use strict'
 
-module.exports = () => {
+const startOfDay = require('./startOfDay')
 
-	const date = new Date()
-
-	date.setHours(0)
-	date.setMinutes(0)
-	date.setSeconds(0)
-	date.setMilliseconds(0)
-
-	return date
-
-}
\ No newline at end of file
+// Returns the start of the current day in the reporting time zone
+module.exports = () => startOfDay()
\ No newline at end of file
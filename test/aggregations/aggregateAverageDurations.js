@@ -0,0 +1,14 @@
+'use strict'
+
+const test = require('ava')
+const uuid = require('uuid').v4
+
+const aggregateAverageDurations = require('../../src/aggregations/aggregateAverageDurations')
+
+test('return array', async (t) => {
+
+	const result = aggregateAverageDurations(uuid())
+
+	t.true(Array.isArray(result))
+
+})
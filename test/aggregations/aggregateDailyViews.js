@@ -5,18 +5,19 @@ const uuid = require('uuid').v4
 
 const aggregateDailyViews = require('../../src/aggregations/aggregateDailyViews')
 
-test('return unique aggregation', async (t) => {
+test('return aggregation', async (t) => {
 
-	const result = aggregateDailyViews(uuid(), true)
+	const result = aggregateDailyViews(uuid())
 
 	t.true(Array.isArray(result))
 
 })
 
-test('return non-unique aggregation', async (t) => {
+test('return aggregation with custom range', async (t) => {
 
-	const result = aggregateDailyViews(uuid(), false)
+	const result = aggregateDailyViews(uuid(), { from: 20200501, to: 20200630 })
 
 	t.true(Array.isArray(result))
+	t.false(result.some((stage) => stage.$limit != null))
 
 })
\ No newline at end of file
@@ -0,0 +1,22 @@
+'use strict'
+
+const test = require('ava')
+const uuid = require('uuid').v4
+
+const aggregateDetailedDurations = require('../../src/aggregations/aggregateDetailedDurations')
+
+test('return array', async (t) => {
+
+	const result = aggregateDetailedDurations(uuid(), 20200101)
+
+	t.true(Array.isArray(result))
+
+})
+
+test('return array with end', async (t) => {
+
+	const result = aggregateDetailedDurations(uuid(), 20200101, 20200131)
+
+	t.true(Array.isArray(result))
+
+})
\ No newline at end of file
@@ -0,0 +1,13 @@
+'use strict'
+
+const test = require('ava')
+
+const aggregateDuplicateClients = require('../../src/aggregations/aggregateDuplicateClients')
+
+test('return array', async (t) => {
+
+	const result = aggregateDuplicateClients()
+
+	t.true(Array.isArray(result))
+
+})
\ No newline at end of file
@@ -0,0 +1,13 @@
+'use strict'
+
+const test = require('ava')
+
+const aggregateDurationRollups = require('../../src/aggregations/aggregateDurationRollups')
+
+test('return array', async (t) => {
+
+	const result = aggregateDurationRollups()
+
+	t.true(Array.isArray(result))
+
+})
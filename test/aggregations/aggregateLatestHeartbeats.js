@@ -0,0 +1,14 @@
+'use strict'
+
+const test = require('ava')
+const uuid = require('uuid').v4
+
+const aggregateLatestHeartbeats = require('../../src/aggregations/aggregateLatestHeartbeats')
+
+test('return array', async (t) => {
+
+	const result = aggregateLatestHeartbeats([ uuid() ])
+
+	t.true(Array.isArray(result))
+
+})
\ No newline at end of file
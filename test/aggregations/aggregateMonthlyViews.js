@@ -5,17 +5,9 @@ const uuid = require('uuid').v4
 
 const aggregateMonthlyViews = require('../../src/aggregations/aggregateMonthlyViews')
 
-test('return unique aggregation', async (t) => {
+test('return aggregation', async (t) => {
 
-	const result = aggregateMonthlyViews(uuid(), true)
-
-	t.true(Array.isArray(result))
-
-})
-
-test('return non-unique aggregation', async (t) => {
-
-	const result = aggregateMonthlyViews(uuid(), false)
+	const result = aggregateMonthlyViews(uuid())
 
 	t.true(Array.isArray(result))
 
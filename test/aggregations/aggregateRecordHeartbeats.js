@@ -0,0 +1,13 @@
+'use strict'
+
+const test = require('ava')
+
+const aggregateRecordHeartbeats = require('../../src/aggregations/aggregateRecordHeartbeats')
+
+test('return array', async (t) => {
+
+	const result = aggregateRecordHeartbeats('heartbeats')
+
+	t.true(Array.isArray(result))
+
+})
\ No newline at end of file
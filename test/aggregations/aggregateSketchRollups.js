@@ -0,0 +1,21 @@
+'use strict'
+
+const test = require('ava')
+
+const aggregateSketchRollups = require('../../src/aggregations/aggregateSketchRollups')
+
+test('return aggregation of one property', async (t) => {
+
+	const result = aggregateSketchRollups([ 'siteLocation' ], 100)
+
+	t.true(Array.isArray(result))
+
+})
+
+test('return aggregation of multiple properties', async (t) => {
+
+	const result = aggregateSketchRollups([ 'osName', 'osVersion' ], 100)
+
+	t.true(Array.isArray(result))
+
+})
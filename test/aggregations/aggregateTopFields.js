@@ -4,6 +4,16 @@ const test = require('ava')
 const uuid = require('uuid').v4
 
 const aggregateTopFields = require('../../src/aggregations/aggregateTopFields')
+const sampling = require('../../src/utils/sampling')
+const accuracies = require('../../src/constants/accuracies')
+
+// Evaluates the operators of the expression that scales counts
+const evaluate = (expression, document) => {
+	if (typeof expression === 'string' && expression.startsWith('$')) return document[expression.slice(1)]
+	if (expression.$multiply != null) return expression.$multiply.reduce((acc, value) => acc * evaluate(value, document), 1)
+	if (expression.$round != null) return Math.round(evaluate(expression.$round[0], document))
+	return expression
+}
 
 test('return array', async (t) => {
 
@@ -11,4 +21,33 @@ test('return array', async (t) => {
 
 	t.true(Array.isArray(result))
 
-})
\ No newline at end of file
+})
+
+test('return array with sample', async (t) => {
+
+	const result = aggregateTopFields(uuid(), 'siteReferrer', undefined, { threshold: '0ccd', scale: 20 })
+
+	t.true(Array.isArray(result))
+	t.deepEqual(result[0].$match.id, { $lt: '0ccd' })
+
+})
+
+test('scale counts of sample to all records', async (t) => {
+
+	const result = aggregateTopFields(uuid(), 'siteReferrer', undefined, sampling(accuracies.ACCURACIES_APPROXIMATE))
+	const { $addFields } = result[result.length - 1]
+
+	t.is(evaluate($addFields.count, { count: 1 }), 20)
+	t.is(evaluate($addFields.count, { count: 3 }), 60)
+	t.true($addFields.estimated)
+
+})
+
+test('return array with custom range', async (t) => {
+
+	const result = aggregateTopFields(uuid(), 'siteReferrer', { from: 20200501, to: 20200507 })
+
+	t.true(Array.isArray(result))
+	t.deepEqual(Object.keys(result[0].$match.created), [ '$gte', '$lt' ])
+
+})
@@ -0,0 +1,31 @@
+'use strict'
+
+const test = require('ava')
+const uuid = require('uuid').v4
+
+const aggregateTopSketches = require('../../src/aggregations/aggregateTopSketches')
+const ranges = require('../../src/constants/ranges')
+
+test('return aggregation with range', async (t) => {
+
+	const result = aggregateTopSketches(uuid(), 'siteLocation', ranges.RANGES_LAST_7_DAYS)
+
+	t.true(Array.isArray(result))
+
+})
+
+test('return aggregation without range', async (t) => {
+
+	const result = aggregateTopSketches(uuid(), 'siteLocation', ranges.RANGES_ALL_TIME)
+
+	t.true(Array.isArray(result))
+
+})
+
+test('return aggregation with custom range', async (t) => {
+
+	const result = aggregateTopSketches(uuid(), 'siteLocation', { from: 20200501, to: 20200507 })
+
+	t.true(Array.isArray(result))
+
+})
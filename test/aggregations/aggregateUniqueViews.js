@@ -0,0 +1,41 @@
+'use strict'
+
+const test = require('ava')
+const uuid = require('uuid').v4
+
+const aggregateUniqueViews = require('../../src/aggregations/aggregateUniqueViews')
+const constants = require('../../src/constants/views')
+
+test('return daily aggregation', async (t) => {
+
+	const result = aggregateUniqueViews(uuid(), constants.VIEWS_INTERVAL_DAILY)
+
+	t.true(Array.isArray(result))
+
+})
+
+test('return monthly aggregation', async (t) => {
+
+	const result = aggregateUniqueViews(uuid(), constants.VIEWS_INTERVAL_MONTHLY)
+
+	t.true(Array.isArray(result))
+
+})
+
+test('return yearly aggregation', async (t) => {
+
+	const result = aggregateUniqueViews(uuid(), constants.VIEWS_INTERVAL_YEARLY)
+
+	t.true(Array.isArray(result))
+
+})
+
+
+test('return daily aggregation with custom range', async (t) => {
+
+	const result = aggregateUniqueViews(uuid(), constants.VIEWS_INTERVAL_DAILY, { from: 20200501, to: 20200630 })
+
+	t.true(Array.isArray(result))
+	t.false(result.some((stage) => stage.$limit != null))
+
+})
\ No newline at end of file
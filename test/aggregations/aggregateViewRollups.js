@@ -0,0 +1,13 @@
+'use strict'
+
+const test = require('ava')
+
+const aggregateViewRollups = require('../../src/aggregations/aggregateViewRollups')
+
+test('return array', async (t) => {
+
+	const result = aggregateViewRollups()
+
+	t.true(Array.isArray(result))
+
+})
@@ -0,0 +1,23 @@
+'use strict'
+
+const test = require('ava')
+const uuid = require('uuid').v4
+
+const aggregateViewsOfDomains = require('../../src/aggregations/aggregateViewsOfDomains')
+const constants = require('../../src/constants/views')
+
+test('return daily aggregation', async (t) => {
+
+	const result = aggregateViewsOfDomains([ uuid(), uuid() ], constants.VIEWS_INTERVAL_DAILY, { from: 20200501, to: 20200514 })
+
+	t.true(Array.isArray(result))
+
+})
+
+test('return yearly aggregation', async (t) => {
+
+	const result = aggregateViewsOfDomains([ uuid(), uuid() ], constants.VIEWS_INTERVAL_YEARLY, { from: 20070101, to: 20200514 })
+
+	t.true(Array.isArray(result))
+
+})
\ No newline at end of file
@@ -0,0 +1,11 @@
+'use strict'
+
+const test = require('ava')
+
+const accuracies = require('../../src/constants/accuracies')
+
+test('is an object', async (t) => {
+
+	t.is(typeof accuracies, 'object')
+
+})
\ No newline at end of file
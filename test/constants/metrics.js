@@ -0,0 +1,11 @@
+'use strict'
+
+const test = require('ava')
+
+const metrics = require('../../src/constants/metrics')
+
+test('is an object', async (t) => {
+
+	t.is(typeof metrics, 'object')
+
+})
@@ -0,0 +1,112 @@
+'use strict'
+
+const test = require('ava')
+const uuid = require('uuid').v4
+
+// Summaries keep two counters and are compacted right away with more than 20 pending values
+process.env.ACKEE_SKETCH_SIZE = '2'
+
+const Sketch = require('../../src/schemas/Sketch')
+const Record = require('../../src/schemas/Record')
+const sketches = require('../../src/database/sketches')
+const dayKey = require('../../src/utils/dayKey')
+const dayIndex = require('../../src/utils/dayIndex')
+
+const pending = [
+	{ value: 'a', count: 3 },
+	{ value: 'b', count: 2 },
+	{ value: 'c', count: 1 }
+]
+
+const mockSketch = (overfullIds, upsertedIds = {}) => {
+
+	const calls = { writes: [], finds: [], updates: [] }
+
+	Sketch.bulkWrite = async (operations) => {
+		calls.writes.push(operations)
+		return { upsertedIds }
+	}
+	Sketch.find = (filter) => ({
+		lean: async () => {
+			calls.finds.push(filter)
+			return filter.pendingCount == null ? [] : overfullIds.map((_id) => ({ _id }))
+		}
+	})
+	Sketch.findById = (_id) => ({
+		lean: async () => ({ _id, version: 3, hasPending: true, counters: [], pending })
+	})
+	Sketch.updateOne = async (filter, update) => {
+		calls.updates.push({ filter, update })
+		return { nModified: 1 }
+	}
+
+	return calls
+
+}
+
+test.serial('add values to the pending values of all summaries of a day', async (t) => {
+
+	const calls = mockSketch([])
+
+	sketches.count({ domainId: uuid(), created: new Date(), siteLanguage: 'en' })
+	await sketches.flush()
+
+	const [ operations ] = calls.writes
+
+	t.is(operations.length, 11)
+	t.deepEqual(operations[0].updateOne.update.$push.pending.$each, [ { value: 'en', count: 1 } ])
+	t.true(operations[0].updateOne.update.$set.hasPending)
+	t.is(calls.updates.length, 0)
+
+})
+
+test.serial('compact summaries that exceed the limit of pending values', async (t) => {
+
+	const calls = mockSketch([ 'overfull' ])
+
+	sketches.count({ domainId: uuid(), created: new Date(), siteLanguage: 'en' })
+	await sketches.flush()
+
+	t.deepEqual(calls.finds[0], { hasPending: true, pendingCount: { $gt: 20 } })
+	t.is(calls.updates.length, 1)
+
+	const { filter, update } = calls.updates[0]
+
+	t.deepEqual(filter, { _id: 'overfull', version: 3 })
+	t.deepEqual(update.$set.pending, [])
+	t.false(update.$set.hasPending)
+	t.is(update.$set.counters.length, 2)
+
+})
+
+test.serial('fold values of new days into existing blocks', async (t) => {
+
+	const calls = mockSketch([], { 1: 'inserted' })
+	const domainId = uuid()
+	const today = dayKey()
+	const yesterday = dayIndex.toDayKey(dayIndex(today) - 1)
+
+	const entries = [
+		{ domainId, day: today, dimension: 'siteLocation', counters: [ { value: 'a', count: 1, error: 0 } ], version: 0 },
+		{ domainId, day: yesterday, dimension: 'siteLocation', counters: [ { value: 'b', count: 2, error: 0 } ], version: 0 }
+	]
+
+	let aggregations = 0
+	Record.aggregate = () => ({
+		allowDiskUse: async () => aggregations++ === 0 ? entries : []
+	})
+
+	await sketches.fold({ domainId })
+
+	const [ days, blocks ] = calls.writes
+
+	// Summaries of days are only created when they're missing
+	t.is(days.length, 2)
+	t.true(days.every((operation) => operation.updateOne.update.$setOnInsert != null))
+
+	// Only the values of the new day are added to its blocks
+	t.is(blocks.length, 10)
+	t.true(blocks.every((operation) => operation.updateOne.filter.level > 0))
+	t.true(blocks.every((operation) => operation.updateOne.update.$push.pending.$each[0].value === 'b'))
+
+})
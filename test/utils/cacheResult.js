@@ -0,0 +1,70 @@
+'use strict'
+
+const test = require('ava')
+const uuid = require('uuid').v4
+
+process.env.ACKEE_CACHE = 'cached'
+process.env.ACKEE_CACHE_STALENESS = '60000'
+
+const cacheResult = require('../../src/utils/cacheResult')
+const versions = require('../../src/utils/versions')
+
+const counter = () => {
+
+	let count = 0
+
+	return async () => ++count
+
+}
+
+test('return function of metrics without cache', async (t) => {
+
+	const fn = counter()
+	const result = cacheResult('uncached', 'top', fn)
+
+	t.is(result, fn)
+
+})
+
+test('reuse fresh result', async (t) => {
+
+	const id = uuid()
+	const fn = cacheResult('cached', 'top', counter())
+
+	await fn(id, 'allTime')
+	const result = await fn(id, 'allTime')
+
+	t.is(result, 1)
+
+})
+
+test('separate results by arguments', async (t) => {
+
+	const id = uuid()
+	const fn = cacheResult('cached', 'top', counter())
+
+	await fn(id, 'allTime')
+	const result = await fn(id, 'weekly')
+
+	t.is(result, 2)
+
+})
+
+test('reuse fresh result when version changed', async (t) => {
+
+	const id = uuid()
+	const fn = cacheResult('cached', 'top', counter())
+
+	await fn(id, 'allTime')
+	await versions.bump(id)
+	const result = await fn(id, 'allTime')
+
+	t.is(result, 1)
+
+})
+
+test('not trust local versions', async (t) => {
+
+	t.false(versions.shared)
+
+})
@@ -0,0 +1,123 @@
+'use strict'
+
+const test = require('ava')
+
+const compileValidator = require('../../src/utils/compileValidator')
+
+const messages = {
+	general: {
+		default: 'Validator failed for path `{PATH}` with value `{VALUE}`',
+		required: 'Path `{PATH}` is required.'
+	},
+	Number: {
+		min: 'Path `{PATH}` ({VALUE}) is less than minimum allowed value ({MIN}).',
+		max: 'Path `{PATH}` ({VALUE}) is more than maximum allowed value ({MAX}).'
+	},
+	String: {
+		minlength: 'Path `{PATH}` (`{VALUE}`) is shorter than the minimum allowed length ({MINLENGTH}).',
+		maxlength: 'Path `{PATH}` (`{VALUE}`) is longer than the maximum allowed length ({MAXLENGTH}).'
+	}
+}
+
+const schema = {
+	options: {
+		versionKey: '__v'
+	},
+	paths: {
+		_id: { instance: 'ObjectID', options: {} },
+		siteLocation: { instance: 'String', options: { required: true, validate: (value) => value.startsWith('https://') } },
+		siteLanguage: { instance: 'String', options: { minlength: 2, maxlength: 2 } },
+		screenWidth: { instance: 'Number', options: { min: 0, max: 100000 } },
+		created: { instance: 'Date', options: { required: true, default: Date.now } },
+		day: { instance: 'Number', options: { default: function() { return this.created.getUTCDate() } } },
+		__v: { instance: 'Number', options: {} }
+	}
+}
+
+const validate = compileValidator(schema, messages)
+
+test('return document with casted values and defaults', async (t) => {
+
+	const result = validate({
+		siteLocation: 'https://example.com/',
+		screenWidth: '1280',
+		created: '2020-03-05T00:00:00.000Z'
+	})
+
+	t.deepEqual(result, {
+		siteLocation: 'https://example.com/',
+		screenWidth: 1280,
+		created: new Date('2020-03-05T00:00:00.000Z'),
+		day: 5,
+		__v: 0
+	})
+
+})
+
+test('remove unknown properties', async (t) => {
+
+	const result = validate({
+		siteLocation: 'https://example.com/',
+		unknown: true
+	})
+
+	t.false(Object.keys(result).includes('unknown'))
+	t.true(result.created instanceof Date)
+
+})
+
+test('keep null values without running validators', async (t) => {
+
+	const result = validate({
+		siteLocation: 'https://example.com/',
+		siteLanguage: null
+	})
+
+	t.is(result.siteLanguage, null)
+
+})
+
+test('throw validation error with messages of all paths', async (t) => {
+
+	const err = t.throws(() => validate({
+		siteLanguage: 'english',
+		screenWidth: -1
+	}))
+
+	t.is(err.name, 'ValidationError')
+	t.is(err.errors.siteLocation.message, 'Path `siteLocation` is required.')
+	t.is(err.errors.siteLanguage.message, 'Path `siteLanguage` (`english`) is longer than the maximum allowed length (2).')
+	t.is(err.errors.screenWidth.message, 'Path `screenWidth` (-1) is less than minimum allowed value (0).')
+
+})
+
+test('throw validation error of empty required string', async (t) => {
+
+	const err = t.throws(() => validate({
+		siteLocation: ''
+	}))
+
+	t.is(err.errors.siteLocation.message, 'Path `siteLocation` is required.')
+
+})
+
+test('throw validation error of custom validator', async (t) => {
+
+	const err = t.throws(() => validate({
+		siteLocation: 'http://example.com/'
+	}))
+
+	t.is(err.errors.siteLocation.message, 'Validator failed for path `siteLocation` with value `http://example.com/`')
+
+})
+
+test('throw validation error of failed cast', async (t) => {
+
+	const err = t.throws(() => validate({
+		siteLocation: 'https://example.com/',
+		screenWidth: 'wide'
+	}))
+
+	t.is(err.errors.screenWidth.message, 'Cast to Number failed for value "wide" at path "screenWidth"')
+
+})
@@ -0,0 +1,70 @@
+'use strict'
+
+const test = require('ava')
+const uuid = require('uuid').v4
+
+const conditional = require('../../src/utils/conditional')
+
+const createResponse = () => ({
+	headers: {},
+	setHeader(key, value) {
+		this.headers[key] = value
+	},
+	end() {
+		this.ended = true
+	}
+})
+
+test('return result with etag', async (t) => {
+
+	const req = { url: '/', params: { domainId: uuid() }, headers: {} }
+	const res = createResponse()
+
+	const result = await conditional(() => 'result')(req, res)
+
+	t.is(result, 'result')
+	t.is(typeof res.headers.ETag, 'string')
+
+})
+
+test('respond with not modified when etag matches', async (t) => {
+
+	const domainId = uuid()
+	const res = createResponse()
+
+	await conditional(() => 'result')({ url: '/', params: { domainId }, headers: {} }, res)
+
+	const req = { url: '/', params: { domainId }, headers: { 'if-none-match': res.headers.ETag } }
+	const nextRes = createResponse()
+
+	const result = await conditional(() => t.fail())(req, nextRes)
+
+	t.is(result, undefined)
+	t.is(nextRes.statusCode, 304)
+	t.true(nextRes.ended)
+
+})
+
+test('respond with result when a version of another process might have changed', async (t) => {
+
+	const domainId = uuid()
+	const res = createResponse()
+	const now = Date.now
+
+	await conditional(() => 'result')({ url: '/', params: { domainId }, headers: {} }, res)
+
+	// Versions aren't shared without Redis, so bumps of other processes are unknown
+	Date.now = () => now() + 60 * 1000
+
+	try {
+
+		const req = { url: '/', params: { domainId }, headers: { 'if-none-match': res.headers.ETag } }
+		const result = await conditional(() => 'result')(req, createResponse())
+
+		t.is(result, 'result')
+
+	} finally {
+		Date.now = now
+	}
+
+})
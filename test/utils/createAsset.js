@@ -0,0 +1,34 @@
+'use strict'
+
+const zlib = require('zlib')
+const test = require('ava')
+
+const createAsset = require('../../src/utils/createAsset')
+
+test('return asset with compressed variants', async (t) => {
+
+	const result = createAsset({ content: 'html{}', type: 'text/css' })
+
+	t.is(result.type, 'text/css')
+	t.is(result.content.toString(), 'html{}')
+	t.is(zlib.gunzipSync(result.gzip).toString(), 'html{}')
+
+})
+
+test('return same hash for same content', async (t) => {
+
+	const a = createAsset({ content: 'html{}', type: 'text/css' })
+	const b = createAsset({ content: 'html{}', type: 'text/css' })
+
+	t.is(a.hash, b.hash)
+
+})
+
+test('use passed variants', async (t) => {
+
+	const gzip = Buffer.from('gzip')
+	const result = createAsset({ content: 'html{}', type: 'text/css', gzip })
+
+	t.is(result.gzip, gzip)
+
+})
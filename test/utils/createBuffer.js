@@ -0,0 +1,146 @@
+'use strict'
+
+const test = require('ava')
+
+const createBuffer = require('../../src/utils/createBuffer')
+const sleep = require('../../src/utils/sleep')
+
+test('flush when size is reached', async (t) => {
+
+	const flushed = []
+	const buffer = createBuffer({ size: 2, interval: 10000, flush: (entries) => flushed.push(entries) })
+
+	buffer.set('a', 1)
+	await buffer.set('b', 2)
+
+	t.deepEqual(flushed, [ [ 1, 2 ] ])
+	t.is(buffer.size(), 0)
+
+})
+
+test('flush when interval passed', async (t) => {
+
+	const flushed = []
+	const buffer = createBuffer({ size: 10, interval: 10, flush: (entries) => flushed.push(entries) })
+
+	buffer.set('a', 1)
+	await sleep(50)
+
+	t.deepEqual(flushed, [ [ 1 ] ])
+
+})
+
+test('coalesce values with the same key', async (t) => {
+
+	const flushed = []
+	const buffer = createBuffer({ size: 10, interval: 10000, flush: (entries) => flushed.push(entries) })
+
+	buffer.set('a', 1)
+	buffer.set('a', 2)
+	await buffer.flush()
+
+	t.deepEqual(flushed, [ [ 2 ] ])
+
+})
+
+test('skip flush when buffer is empty', async (t) => {
+
+	const flushed = []
+	const buffer = createBuffer({ size: 10, interval: 10000, flush: (entries) => flushed.push(entries) })
+
+	await buffer.flush()
+
+	t.deepEqual(flushed, [])
+
+})
+
+test('return buffered values', async (t) => {
+
+	const buffer = createBuffer({ size: 10, interval: 10000, flush: () => {} })
+
+	buffer.set('a', 1)
+
+	t.true(buffer.has('a'))
+	t.is(buffer.get('a'), 1)
+	t.deepEqual([ ...buffer.values() ], [ 1 ])
+
+})
+
+test('buffer values of failed flush again', async (t) => {
+
+	let attempts = 0
+	const buffer = createBuffer({ size: 10, interval: 10000, flush: () => {
+		if (++attempts === 1) throw new Error('Failed')
+	} })
+
+	buffer.set('a', 1)
+	await buffer.flush()
+
+	t.is(buffer.get('a'), 1)
+
+	await buffer.flush()
+
+	t.is(attempts, 2)
+	t.is(buffer.size(), 0)
+
+})
+
+test('only retry failed entries of flush', async (t) => {
+
+	const buffer = createBuffer({ size: 10, interval: 10000, flush: () => {
+		throw Object.assign(new Error('Failed'), { entries: [ 2 ] })
+	} })
+
+	buffer.set('a', 1)
+	buffer.set('b', 2)
+	await buffer.flush()
+
+	t.deepEqual([ ...buffer.values() ], [ 2 ])
+
+})
+
+test('keep newer values when flush failed', async (t) => {
+
+	const buffer = createBuffer({ size: 10, interval: 10000, flush: async () => {
+		await sleep(20)
+		throw new Error('Failed')
+	} })
+
+	buffer.set('a', 1)
+	const pending = buffer.flush()
+	buffer.set('a', 2)
+	await pending
+
+	t.is(buffer.get('a'), 2)
+
+})
+
+test('return values that are being flushed', async (t) => {
+
+	const buffer = createBuffer({ size: 10, interval: 10000, flush: () => sleep(20) })
+
+	buffer.set('a', 1)
+	const pending = buffer.flush()
+
+	t.false(buffer.has('a'))
+	t.true(buffer.isFlushing('a'))
+	t.deepEqual([ ...buffer.all() ], [ 1 ])
+
+	await pending
+
+	t.false(buffer.isFlushing('a'))
+	t.deepEqual([ ...buffer.all() ], [])
+
+})
+
+test('return number of values that are left after draining', async (t) => {
+
+	const buffer = createBuffer({ size: 10, interval: 10000, flush: () => {
+		throw new Error('Failed')
+	} })
+
+	buffer.set('a', 1)
+
+	t.is(await buffer.drain(2), 1)
+
+})
\ No newline at end of file
@@ -0,0 +1,73 @@
+'use strict'
+
+const test = require('ava')
+
+const createCache = require('../../src/utils/createCache')
+const sleep = require('../../src/utils/sleep')
+
+test('return cached value', async (t) => {
+
+	const cache = createCache()
+
+	cache.set('a', 1)
+
+	t.is(cache.get('a'), 1)
+
+})
+
+test('return undefined for unknown keys', async (t) => {
+
+	const cache = createCache()
+
+	t.is(cache.get('a'), undefined)
+
+})
+
+test('return undefined for deleted keys', async (t) => {
+
+	const cache = createCache()
+
+	cache.set('a', 1)
+	cache.del('a')
+
+	t.is(cache.get('a'), undefined)
+
+})
+
+test('return undefined for expired values', async (t) => {
+
+	const cache = createCache({ ttl: 10 })
+
+	cache.set('a', 1)
+	await sleep(20)
+
+	t.is(cache.get('a'), undefined)
+	t.is(cache.size(), 0)
+
+})
+
+test('drop least recently used value', async (t) => {
+
+	const cache = createCache({ max: 2 })
+
+	cache.set('a', 1)
+	cache.set('b', 2)
+	cache.get('a')
+	cache.set('c', 3)
+
+	t.is(cache.get('a'), 1)
+	t.is(cache.get('b'), undefined)
+	t.is(cache.get('c'), 3)
+
+})
+
+test('clear all values', async (t) => {
+
+	const cache = createCache()
+
+	cache.set('a', 1)
+	cache.clear()
+
+	t.is(cache.size(), 0)
+
+})
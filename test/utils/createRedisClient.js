@@ -0,0 +1,79 @@
+'use strict'
+
+const test = require('ava')
+const net = require('net')
+
+const createRedisClient = require('../../src/utils/createRedisClient')
+
+// Fake Redis server that answers each command with the next reply
+const listen = (replies) => new Promise((resolve) => {
+
+	const commands = []
+	const sockets = []
+
+	const server = net.createServer((socket) => {
+		sockets.push(socket)
+		socket.on('data', (data) => {
+			commands.push(data.toString())
+			socket.write(replies.shift())
+		})
+	})
+
+	const close = () => {
+		sockets.forEach((socket) => socket.destroy())
+		server.close()
+	}
+
+	server.listen(0, () => resolve({ close, commands, url: `redis://127.0.0.1:${ server.address().port }` }))
+
+})
+
+test('send commands in RESP format', async (t) => {
+
+	const { close, commands, url } = await listen([ '+OK\r\n' ])
+	const client = createRedisClient(url)
+
+	await client.command('SET', 'key', 'value')
+
+	t.is(commands[0], '*3\r\n$3\r\nSET\r\n$3\r\nkey\r\n$5\r\nvalue\r\n')
+
+	close()
+
+})
+
+test('return parsed replies', async (t) => {
+
+	const { close, url } = await listen([ '+OK\r\n', ':42\r\n', '$5\r\nvalue\r\n', '$-1\r\n', '*2\r\n:1\r\n$1\r\na\r\n' ])
+	const client = createRedisClient(url)
+
+	t.is(await client.command('SET', 'key', 'value'), 'OK')
+	t.is(await client.command('INCR', 'key'), 42)
+	t.is(await client.command('GET', 'key'), 'value')
+	t.is(await client.command('GET', 'unknown'), null)
+	t.deepEqual(await client.command('LRANGE', 'list', 0, 1), [ 1, 'a' ])
+
+	close()
+
+})
+
+test('reject error replies', async (t) => {
+
+	const { close, url } = await listen([ '-ERR unknown command\r\n' ])
+	const client = createRedisClient(url)
+
+	await t.throwsAsync(client.command('UNKNOWN'), { message: 'ERR unknown command' })
+
+	close()
+
+})
+
+test('reject commands when authentication fails', async (t) => {
+
+	const { close, url } = await listen([ '-ERR invalid password\r\n', '-NOAUTH Authentication required\r\n' ])
+	const client = createRedisClient(url.replace('redis://', 'redis://:secret@'))
+
+	await t.throwsAsync(client.command('GET', 'key'))
+
+	close()
+
+})
\ No newline at end of file
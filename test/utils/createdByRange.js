@@ -0,0 +1,23 @@
+'use strict'
+
+const test = require('ava')
+
+const createdByRange = require('../../src/utils/createdByRange')
+const ranges = require('../../src/constants/ranges')
+
+test('return undefined without start', async (t) => {
+
+	t.is(createdByRange(ranges.RANGES_ALL_TIME), undefined)
+
+})
+
+test('return whole days of custom range', async (t) => {
+
+	const result = createdByRange({ from: 20200501, to: 20200507 })
+
+	t.deepEqual(result, {
+		$gte: new Date('2020-05-01T00:00:00.000Z'),
+		$lt: new Date('2020-05-08T00:00:00.000Z')
+	})
+
+})
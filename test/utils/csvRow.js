@@ -0,0 +1,30 @@
+'use strict'
+
+const test = require('ava')
+
+const csvRow = require('../../src/utils/csvRow')
+
+test('return line of values', async (t) => {
+
+	const result = csvRow([ 'a', 1, null, undefined ])
+
+	t.is(result, 'a,1,,\n')
+
+})
+
+test('quote values with separators, quotes and line breaks', async (t) => {
+
+	const result = csvRow([ 'a,b', 'a"b', 'a\nb' ])
+
+	t.is(result, '"a,b","a""b","a\nb"\n')
+
+})
+
+test('format dates as ISO string', async (t) => {
+
+	const date = new Date(0)
+	const result = csvRow([ date ])
+
+	t.is(result, `${ date.toISOString() }\n`)
+
+})
@@ -0,0 +1,27 @@
+'use strict'
+
+const test = require('ava')
+
+const dateParts = require('../../src/utils/dateParts')
+
+test('return UTC parts', async (t) => {
+
+	const result = dateParts(new Date(Date.UTC(2020, 4, 3, 0, 15)), 'UTC')
+
+	t.deepEqual(result, { year: 2020, month: 5, day: 3, hour: 0, minute: 15 })
+
+})
+
+test('return parts in time zone', async (t) => {
+
+	const result = dateParts(new Date(Date.UTC(2020, 4, 3, 0, 15)), 'Asia/Kolkata')
+
+	t.deepEqual(result, { year: 2020, month: 5, day: 3, hour: 5, minute: 45 })
+
+})
+
+test('throw for unknown time zone', async (t) => {
+
+	t.throws(() => dateParts(new Date(), 'Nowhere/Unknown'))
+
+})
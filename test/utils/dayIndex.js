@@ -0,0 +1,18 @@
+'use strict'
+
+const test = require('ava')
+
+const dayIndex = require('../../src/utils/dayIndex')
+
+test('return number of days since 1970', async (t) => {
+
+	t.is(dayIndex(19700101), 0)
+	t.is(dayIndex(19700201), 31)
+
+})
+
+test('return day of index', async (t) => {
+
+	t.is(dayIndex.toDayKey(dayIndex(20200229)), 20200229)
+
+})
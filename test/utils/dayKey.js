@@ -0,0 +1,37 @@
+'use strict'
+
+const test = require('ava')
+
+const dayKey = require('../../src/utils/dayKey')
+
+test('return key of date', async (t) => {
+
+	const result = dayKey(new Date(Date.UTC(2020, 4, 3, 12)))
+
+	t.is(result, 20200503)
+
+})
+
+test('return key of UTC day', async (t) => {
+
+	const result = dayKey(new Date(Date.UTC(2020, 11, 31, 23, 59, 59)))
+
+	t.is(result, 20201231)
+
+})
+
+test('return key of current day by default', async (t) => {
+
+	const result = dayKey()
+
+	t.is(result, dayKey(new Date()))
+
+})
+
+test('return key of day in time zone', async (t) => {
+
+	const result = dayKey(new Date(Date.UTC(2020, 11, 31, 23, 59, 59)), 'Europe/Berlin')
+
+	t.is(result, 20210101)
+
+})
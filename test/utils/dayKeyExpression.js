@@ -0,0 +1,14 @@
+'use strict'
+
+const test = require('ava')
+
+const dayKeyExpression = require('../../src/utils/dayKeyExpression')
+
+test('return expression', async (t) => {
+
+	const result = dayKeyExpression()
+
+	t.true(Array.isArray(result.$ifNull))
+	t.is(result.$ifNull[0], '$day')
+
+})
@@ -0,0 +1,22 @@
+'use strict'
+
+const test = require('ava')
+
+const dayRange = require('../../src/utils/dayRange')
+const ranges = require('../../src/constants/ranges')
+
+test('return days of custom range', async (t) => {
+
+	const range = { from: 20200501, to: 20200507 }
+
+	t.deepEqual(dayRange(range), range)
+
+})
+
+test('return all days', async (t) => {
+
+	const result = dayRange(ranges.RANGES_ALL_TIME)
+
+	t.is(result.from, 19700101)
+
+})
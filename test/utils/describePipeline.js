@@ -0,0 +1,24 @@
+'use strict'
+
+const test = require('ava')
+
+const describePipeline = require('../../src/utils/describePipeline')
+
+test('return stages and match fields', async (t) => {
+
+	const result = describePipeline([
+		{ $match: { domainId: 'id', created: { $gte: new Date() } } },
+		{ $group: { _id: '$siteLocation', count: { $sum: 1 } } },
+		{ $sort: { count: -1 } },
+		{ $limit: 30 }
+	])
+
+	t.is(result, '$match(domainId,created) $group $sort $limit')
+
+})
+
+test('return empty string for empty pipeline', async (t) => {
+
+	t.is(describePipeline([]), '')
+
+})
@@ -0,0 +1,35 @@
+'use strict'
+
+const test = require('ava')
+
+const durationBucket = require('../../src/utils/durationBucket')
+const constants = require('../../src/constants/durations')
+
+test('return first bucket for new records', async (t) => {
+
+	const created = new Date()
+	const result = durationBucket(created, created)
+
+	t.is(result, 0)
+
+})
+
+test('round down to the interval', async (t) => {
+
+	const created = new Date(0)
+	const updated = new Date(constants.DURATIONS_INTERVAL * 2.5)
+	const result = durationBucket(created, updated)
+
+	t.is(result, 2)
+
+})
+
+test('return last bucket for durations above the limit', async (t) => {
+
+	const created = new Date(0)
+	const updated = new Date(constants.DURATIONS_LIMIT * 3)
+	const result = durationBucket(created, updated)
+
+	t.is(result, constants.DURATIONS_LIMIT / constants.DURATIONS_INTERVAL)
+
+})
@@ -0,0 +1,37 @@
+'use strict'
+
+const test = require('ava')
+
+const dyadicBlocks = require('../../src/utils/dyadicBlocks')
+
+test('return single day', async (t) => {
+
+	t.deepEqual(dyadicBlocks(5, 5), [ { level: 0, start: 5 } ])
+
+})
+
+test('cover range with aligned blocks', async (t) => {
+
+	const result = dyadicBlocks(3, 12)
+
+	t.deepEqual(result, [
+		{ level: 0, start: 3 },
+		{ level: 2, start: 4 },
+		{ level: 2, start: 8 },
+		{ level: 0, start: 12 }
+	])
+
+})
+
+test('return blocks containing a day', async (t) => {
+
+	const result = dyadicBlocks.containing(5)
+
+	t.is(result.length, 10)
+	t.deepEqual(result.slice(0, 3), [
+		{ level: 1, start: 4 },
+		{ level: 2, start: 4 },
+		{ level: 3, start: 0 }
+	])
+
+})
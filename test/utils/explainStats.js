@@ -0,0 +1,62 @@
+'use strict'
+
+const test = require('ava')
+
+const explainStats = require('../../src/utils/explainStats')
+
+test('return stats of pipeline with cursor stage', async (t) => {
+
+	const result = explainStats({
+		stages: [
+			{
+				$cursor: {
+					queryPlanner: {
+						winningPlan: {
+							stage: 'FETCH',
+							inputStage: {
+								stage: 'IXSCAN',
+								indexName: 'domainId_1_created_-1'
+							}
+						}
+					},
+					executionStats: {
+						totalDocsExamined: 10,
+						totalKeysExamined: 12
+					}
+				}
+			},
+			{
+				$group: {},
+				usedDisk: true
+			}
+		]
+	})
+
+	t.deepEqual(result, {
+		docsExamined: 10,
+		keysExamined: 12,
+		indexes: [ 'domainId_1_created_-1' ],
+		collectionScan: false,
+		usedDisk: true
+	})
+
+})
+
+test('detect collection scans', async (t) => {
+
+	const result = explainStats({
+		queryPlanner: {
+			winningPlan: {
+				stage: 'COLLSCAN'
+			}
+		},
+		executionStats: {
+			totalDocsExamined: 100,
+			totalKeysExamined: 0
+		}
+	})
+
+	t.true(result.collectionScan)
+	t.is(result.docsExamined, 100)
+
+})
@@ -0,0 +1,69 @@
+'use strict'
+
+const crypto = require('crypto')
+const test = require('ava')
+
+const hyperLogLog = require('../../src/utils/hyperLogLog')
+
+const hash = (value) => crypto.createHash('sha256').update(`${ value }`).digest('hex')
+
+const count = (values) => {
+
+	const registers = new Map()
+
+	values.forEach((value) => {
+		const { index, rank } = hyperLogLog.register(hash(value))
+		registers.set(index, Math.max(registers.get(index) || 0, rank))
+	})
+
+	const sum = [ ...registers.values() ].reduce((acc, rank) => acc + 2 ** -rank, 0)
+
+	return hyperLogLog.estimate(sum, registers.size)
+
+}
+
+test('return register of hash', async (t) => {
+
+	const result = hyperLogLog.register('fff0a' + '0'.repeat(59))
+
+	t.deepEqual(result, { index: 4095, rank: 5 })
+
+})
+
+test('return index in range', async (t) => {
+
+	const { index } = hyperLogLog.register(hash('a'))
+
+	t.true(index >= 0 && index < hyperLogLog.SIZE)
+
+})
+
+test('estimate zero without registers', async (t) => {
+
+	t.is(hyperLogLog.estimate(0, 0), 0)
+
+})
+
+test('estimate small cardinalities', async (t) => {
+
+	const values = Array.from({ length: 100 }, (_, index) => index)
+
+	t.true(Math.abs(count(values) - 100) <= 5)
+
+})
+
+test('estimate large cardinalities', async (t) => {
+
+	const values = Array.from({ length: 50000 }, (_, index) => index)
+
+	t.true(Math.abs(count(values) - 50000) <= 50000 * 0.05)
+
+})
+
+test('ignore duplicates', async (t) => {
+
+	const values = Array.from({ length: 1000 }, (_, index) => index % 10)
+
+	t.true(Math.abs(count(values) - 10) <= 1)
+
+})
@@ -1,9 +1,11 @@
 'use strict'
 
+const crypto = require('crypto')
 const test = require('ava')
 const uuid = require('uuid').v4
 
 const identifier = require('../../src/utils/identifier')
+const salt = require('../../src/utils/salt')
 
 test('return different identifiers', async (t) => {
 
@@ -43,4 +45,25 @@ test('return same identifiers', async (t) => {
 
 	t.is(a, b)
 
+})
+
+test('return hash of salt, ip, user-agent and domain', async (t) => {
+
+	const domainId = uuid()
+	const userAgent = uuid()
+	const ip = '127.0.0.1'
+
+	const req = {
+		headers: {
+			'user-agent': userAgent
+		},
+		connection: {
+			remoteAddress: ip
+		}
+	}
+
+	const hash = crypto.createHash('sha256').update(`${ salt() }${ ip }${ userAgent }${ domainId }`).digest('hex')
+
+	t.is(identifier(req, domainId), hash)
+
 })
\ No newline at end of file
@@ -0,0 +1,25 @@
+'use strict'
+
+const test = require('ava')
+
+const intervalStart = require('../../src/utils/intervalStart')
+const constants = require('../../src/constants/views')
+
+test('return first day of latest days', async (t) => {
+
+	t.is(intervalStart(constants.VIEWS_INTERVAL_DAILY, 14, 20200305), 20200221)
+
+})
+
+test('return first day of latest months', async (t) => {
+
+	t.is(intervalStart(constants.VIEWS_INTERVAL_MONTHLY, 14, 20200305), 20190201)
+	t.is(intervalStart(constants.VIEWS_INTERVAL_MONTHLY, 1, 20200305), 20200301)
+
+})
+
+test('return first day of latest years', async (t) => {
+
+	t.is(intervalStart(constants.VIEWS_INTERVAL_YEARLY, 14, 20200305), 20070101)
+
+})
\ No newline at end of file
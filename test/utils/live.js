@@ -0,0 +1,24 @@
+'use strict'
+
+const test = require('ava')
+const uuid = require('uuid').v4
+
+const live = require('../../src/utils/live')
+
+test('notify subscribers of domain', async (t) => {
+
+	const id = uuid()
+	const deltas = []
+
+	const unsubscribe = live.subscribe([ id, uuid() ], (domainId, delta) => deltas.push({ domainId, delta }))
+
+	live.publish(id, { siteLocation: 'https://example.com' })
+	live.publish(uuid(), { siteLocation: 'https://example.com' })
+
+	unsubscribe()
+
+	live.publish(id, { siteLocation: 'https://example.com' })
+
+	t.deepEqual(deltas, [ { domainId: id, delta: { siteLocation: 'https://example.com' } } ])
+
+})
@@ -0,0 +1,41 @@
+'use strict'
+
+const test = require('ava')
+
+const mapLimit = require('../../src/utils/mapLimit')
+const sleep = require('../../src/utils/sleep')
+
+test('return results in order of the items', async (t) => {
+
+	const result = await mapLimit([ 30, 10, 20 ], 3, async (item) => {
+		await sleep(item)
+		return item * 2
+	})
+
+	t.deepEqual(result, [ 60, 20, 40 ])
+
+})
+
+test('run at most limit calls at the same time', async (t) => {
+
+	let running = 0
+	let maxRunning = 0
+
+	await mapLimit(Array(10).fill(), 3, async () => {
+		running++
+		maxRunning = Math.max(maxRunning, running)
+		await sleep(5)
+		running--
+	})
+
+	t.is(maxRunning, 3)
+
+})
+
+test('return empty array for no items', async (t) => {
+
+	const result = await mapLimit([], 3, async (item) => item)
+
+	t.deepEqual(result, [])
+
+})
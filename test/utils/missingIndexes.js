@@ -0,0 +1,38 @@
+'use strict'
+
+const test = require('ava')
+
+const missingIndexes = require('../../src/utils/missingIndexes')
+
+const model = (declared, existing) => ({
+	schema: {
+		indexes: () => declared.map((key) => [ key, {} ])
+	},
+	collection: {
+		indexes: async () => existing.map((key) => ({ key }))
+	}
+})
+
+test('return empty array when all indexes exist', async (t) => {
+
+	const result = await missingIndexes(model([ { id: 1 }, { domainId: 1, created: -1 } ], [ { _id: 1 }, { id: 1 }, { domainId: 1, created: -1 } ]))
+
+	t.deepEqual(result, [])
+
+})
+
+test('return missing indexes', async (t) => {
+
+	const result = await missingIndexes(model([ { id: 1 }, { domainId: 1, created: -1 } ], [ { _id: 1 }, { id: 1 } ]))
+
+	t.deepEqual(result, [ { domainId: 1, created: -1 } ])
+
+})
+
+test('compare the order and direction of keys', async (t) => {
+
+	const result = await missingIndexes(model([ { domainId: 1, created: -1 } ], [ { created: -1, domainId: 1 }, { domainId: 1, created: 1 } ]))
+
+	t.deepEqual(result, [ { domainId: 1, created: -1 } ])
+
+})
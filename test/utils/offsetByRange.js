@@ -2,17 +2,22 @@
 
 const test = require('ava')
 
-const { subDays } = require('date-fns')
+// Ranges must start at midnight of the reporting time zone, independent of the time zone of the server
+process.env.ACKEE_TIMEZONE = 'America/Los_Angeles'
 
 const ranges = require('../../src/constants/ranges')
-const zeroDate = require('../../src/utils/zeroDate')
+const dayKey = require('../../src/utils/dayKey')
+const dayIndex = require('../../src/utils/dayIndex')
+const startOfDay = require('../../src/utils/startOfDay')
 const offsetByRange = require('../../src/utils/offsetByRange')
 
+const daysAgo = (days) => dayIndex.toDayKey(dayIndex(dayKey()) - days)
+
 test('return correct offset for RANGES_LAST_24_HOURS', async (t) => {
 
 	const result = offsetByRange(ranges.RANGES_LAST_24_HOURS)
 
-	t.deepEqual(result, subDays(zeroDate(), 1))
+	t.is(dayKey(result), daysAgo(1))
 
 })
 
@@ -20,7 +25,7 @@ test('return correct offset for RANGES_LAST_7_DAYS', async (t) => {
 
 	const result = offsetByRange(ranges.RANGES_LAST_7_DAYS)
 
-	t.deepEqual(result, subDays(zeroDate(), 6))
+	t.is(dayKey(result), daysAgo(6))
 
 })
 
@@ -28,7 +33,16 @@ test('return correct offset for RANGES_LAST_30_DAYS', async (t) => {
 
 	const result = offsetByRange(ranges.RANGES_LAST_30_DAYS)
 
-	t.deepEqual(result, subDays(zeroDate(), 29))
+	t.is(dayKey(result), daysAgo(29))
+
+})
+
+test('return midnight of the reporting time zone', async (t) => {
+
+	const result = offsetByRange(ranges.RANGES_LAST_7_DAYS)
+
+	t.deepEqual(result, startOfDay(result))
+	t.is(dayKey(new Date(result.getTime() - 1)), daysAgo(7))
 
 })
 
@@ -0,0 +1,21 @@
+'use strict'
+
+const test = require('ava')
+
+const parseArgs = require('../../src/utils/parseArgs')
+
+test('return options with values', async (t) => {
+
+	const result = parseArgs([ '--rate=10', '--url=http://localhost:3000/?a=b' ])
+
+	t.deepEqual(result, { rate: '10', url: 'http://localhost:3000/?a=b' })
+
+})
+
+test('return options without values', async (t) => {
+
+	const result = parseArgs([ '--seed' ])
+
+	t.deepEqual(result, { seed: true })
+
+})
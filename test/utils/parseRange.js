@@ -0,0 +1,25 @@
+'use strict'
+
+const test = require('ava')
+
+const parseRange = require('../../src/utils/parseRange')
+
+test('return undefined without range', async (t) => {
+
+	t.is(parseRange(), undefined)
+
+})
+
+test('return days of range', async (t) => {
+
+	t.deepEqual(parseRange('2020-05-01T12:00:00Z', '2020-05-07T12:00:00Z'), { from: 20200501, to: 20200507 })
+
+})
+
+test('return null for invalid range', async (t) => {
+
+	t.is(parseRange(undefined, '2020-05-07'), null)
+	t.is(parseRange('invalid'), null)
+	t.is(parseRange('2020-05-07', '2020-05-01'), null)
+
+})
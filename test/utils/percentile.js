@@ -0,0 +1,28 @@
+'use strict'
+
+const test = require('ava')
+
+const percentile = require('../../src/utils/percentile')
+
+const values = Array.from({ length: 100 }, (_, index) => index + 1)
+
+test('return percentiles of values', async (t) => {
+
+	t.is(percentile(values, 50), 50)
+	t.is(percentile(values, 95), 95)
+	t.is(percentile(values, 99), 99)
+
+})
+
+test('return smallest and largest value', async (t) => {
+
+	t.is(percentile(values, 0), 1)
+	t.is(percentile(values, 100), 100)
+
+})
+
+test('return null without values', async (t) => {
+
+	t.is(percentile([], 50), null)
+
+})
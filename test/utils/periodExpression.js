@@ -0,0 +1,18 @@
+'use strict'
+
+const test = require('ava')
+
+const periodExpression = require('../../src/utils/periodExpression')
+const constants = require('../../src/constants/views')
+
+test('return expression of days', async (t) => {
+
+	t.deepEqual(Object.keys(periodExpression(constants.VIEWS_INTERVAL_DAILY)), [ 'day', 'month', 'year' ])
+
+})
+
+test('return expression of years', async (t) => {
+
+	t.deepEqual(Object.keys(periodExpression(constants.VIEWS_INTERVAL_YEARLY)), [ 'year' ])
+
+})
\ No newline at end of file
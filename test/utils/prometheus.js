@@ -0,0 +1,80 @@
+'use strict'
+
+const test = require('ava')
+
+const prometheus = require('../../src/utils/prometheus')
+
+test('render counter', async (t) => {
+
+	const registry = prometheus()
+	const counter = registry.counter('requests_total', 'Requests')
+
+	counter.inc({ route: '/' })
+	counter.inc({ route: '/' }, 2)
+
+	const result = registry.render()
+
+	t.true(result.includes('# TYPE requests_total counter'))
+	t.true(result.includes('requests_total{route="/"} 3'))
+
+})
+
+test('render gauge', async (t) => {
+
+	const registry = prometheus()
+	registry.gauge('heap_bytes', 'Heap', () => 42)
+
+	t.true(registry.render().includes('heap_bytes 42'))
+
+})
+
+test('render histogram', async (t) => {
+
+	const registry = prometheus()
+	const histogram = registry.histogram('duration_seconds', 'Duration', [ 0.1, 1 ])
+
+	histogram.observe({ route: '/' }, 0.5)
+	histogram.observe({ route: '/' }, 2)
+
+	const result = registry.render()
+
+	t.true(result.includes('duration_seconds_bucket{route="/",le="0.1"} 0'))
+	t.true(result.includes('duration_seconds_bucket{route="/",le="1"} 1'))
+	t.true(result.includes('duration_seconds_bucket{route="/",le="+Inf"} 2'))
+	t.true(result.includes('duration_seconds_sum{route="/"} 2.5'))
+	t.true(result.includes('duration_seconds_count{route="/"} 2'))
+
+})
+
+test('escape label values', async (t) => {
+
+	const registry = prometheus()
+	registry.counter('requests_total', 'Requests').inc({ route: '"a"' })
+
+	t.true(registry.render().includes('requests_total{route="\\"a\\""} 1'))
+
+})
+
+test('add labels to collected samples', async (t) => {
+
+	const registry = prometheus()
+	registry.gauge('heap_bytes', 'Heap', () => 42)
+
+	const [ metric ] = registry.collect({ worker: 1 })
+
+	t.deepEqual(metric.samples, [ { name: 'heap_bytes', labels: { worker: 1 }, value: 42 } ])
+
+})
+
+test('render merged samples of multiple registries', async (t) => {
+
+	const registries = [ prometheus(), prometheus() ]
+	registries.forEach((registry, index) => registry.gauge('heap_bytes', 'Heap', () => index))
+
+	const result = prometheus.render(registries.map((registry, index) => registry.collect({ worker: index })))
+
+	t.is(result.split('# TYPE heap_bytes gauge').length, 2)
+	t.true(result.includes('heap_bytes{worker="0"} 0'))
+	t.true(result.includes('heap_bytes{worker="1"} 1'))
+
+})
\ No newline at end of file
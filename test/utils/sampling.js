@@ -0,0 +1,22 @@
+'use strict'
+
+const test = require('ava')
+
+const sampling = require('../../src/utils/sampling')
+const accuracies = require('../../src/constants/accuracies')
+
+test('return sample of approximate accuracy', async (t) => {
+
+	const result = sampling(accuracies.ACCURACIES_APPROXIMATE)
+
+	t.is(result.threshold, '0ccd')
+	t.is(Math.round(result.scale), 20)
+
+})
+
+test('return undefined for exact accuracy', async (t) => {
+
+	t.is(sampling(accuracies.ACCURACIES_EXACT), undefined)
+	t.is(sampling(), undefined)
+
+})
@@ -0,0 +1,69 @@
+'use strict'
+
+const test = require('ava')
+
+const sendAsset = require('../../src/utils/sendAsset')
+
+const asset = {
+	type: 'text/css',
+	hash: 'hash',
+	content: Buffer.from('content'),
+	gzip: Buffer.from('gzip'),
+	brotli: Buffer.from('brotli')
+}
+
+const createRes = () => {
+
+	const res = {
+		statusCode: 200,
+		headers: {},
+		setHeader: (key, value) => res.headers[key] = value,
+		end: (data) => res.data = data
+	}
+
+	return res
+
+}
+
+test('prefer brotli', async (t) => {
+
+	const res = createRes()
+	sendAsset({ headers: { 'accept-encoding': 'gzip, deflate, br' } }, res, asset, 'no-cache')
+
+	t.is(res.headers['Content-Encoding'], 'br')
+	t.is(res.headers.ETag, '"hash-br"')
+	t.is(res.data, asset.brotli)
+
+})
+
+test('use gzip when brotli is disabled', async (t) => {
+
+	const res = createRes()
+	sendAsset({ headers: { 'accept-encoding': 'gzip, br;q=0' } }, res, asset, 'no-cache')
+
+	t.is(res.headers['Content-Encoding'], 'gzip')
+	t.is(res.data, asset.gzip)
+
+})
+
+test('send uncompressed content by default', async (t) => {
+
+	const res = createRes()
+	sendAsset({ headers: {} }, res, asset, 'no-cache')
+
+	t.is(res.headers['Content-Encoding'], undefined)
+	t.is(res.headers.ETag, '"hash"')
+	t.is(res.headers['Cache-Control'], 'no-cache')
+	t.is(res.data, asset.content)
+
+})
+
+test('return 304 when ETag matches', async (t) => {
+
+	const res = createRes()
+	sendAsset({ headers: { 'if-none-match': '"other", "hash"' } }, res, asset, 'no-cache')
+
+	t.is(res.statusCode, 304)
+	t.is(res.data, undefined)
+
+})
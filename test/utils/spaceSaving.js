@@ -0,0 +1,57 @@
+'use strict'
+
+const test = require('ava')
+
+const spaceSaving = require('../../src/utils/spaceSaving')
+
+test('add values to an empty summary', async (t) => {
+
+	const result = spaceSaving([], [ { value: 'a', count: 1 }, { value: 'b', count: 2 } ], 10)
+
+	t.deepEqual(result, [
+		{ value: 'b', count: 2, error: 0 },
+		{ value: 'a', count: 1, error: 0 }
+	])
+
+})
+
+test('increase tracked values', async (t) => {
+
+	const result = spaceSaving([ { value: 'a', count: 1, error: 0 } ], [ { value: 'a', count: 2 } ], 10)
+
+	t.deepEqual(result, [ { value: 'a', count: 3, error: 0 } ])
+
+})
+
+test('replace smallest counter when full', async (t) => {
+
+	const counters = [
+		{ value: 'a', count: 5, error: 0 },
+		{ value: 'b', count: 2, error: 0 }
+	]
+
+	const result = spaceSaving(counters, [ { value: 'c', count: 1 } ], 2)
+
+	t.deepEqual(result, [
+		{ value: 'a', count: 5, error: 0 },
+		{ value: 'c', count: 3, error: 2 }
+	])
+
+})
+
+test('remove tracked values', async (t) => {
+
+	const result = spaceSaving([ { value: 'a', count: 1, error: 0 } ], [ { value: 'a', count: -2 }, { value: 'b', count: -1 } ], 10)
+
+	t.deepEqual(result, [ { value: 'a', count: 0, error: 0 } ])
+
+})
+
+test('compare object values', async (t) => {
+
+	const counters = [ { value: { osName: 'Linux', osVersion: '1' }, count: 1, error: 0 } ]
+	const result = spaceSaving(counters, [ { value: { osName: 'Linux', osVersion: '1' }, count: 1 } ], 1)
+
+	t.deepEqual(result, [ { value: { osName: 'Linux', osVersion: '1' }, count: 2, error: 0 } ])
+
+})
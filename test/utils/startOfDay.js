@@ -0,0 +1,29 @@
+'use strict'
+
+const test = require('ava')
+
+const startOfDay = require('../../src/utils/startOfDay')
+
+test('return UTC midnight', async (t) => {
+
+	const result = startOfDay(new Date(Date.UTC(2020, 4, 3, 12)), 'UTC')
+
+	t.is(result.toISOString(), '2020-05-03T00:00:00.000Z')
+
+})
+
+test('return midnight of time zone ahead of UTC', async (t) => {
+
+	const result = startOfDay(new Date(Date.UTC(2020, 4, 3, 12)), 'Europe/Berlin')
+
+	t.is(result.toISOString(), '2020-05-02T22:00:00.000Z')
+
+})
+
+test('return midnight of time zone behind UTC', async (t) => {
+
+	const result = startOfDay(new Date(Date.UTC(2020, 4, 3, 2)), 'America/New_York')
+
+	t.is(result.toISOString(), '2020-05-02T04:00:00.000Z')
+
+})
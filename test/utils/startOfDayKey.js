@@ -0,0 +1,21 @@
+'use strict'
+
+const test = require('ava')
+
+const startOfDayKey = require('../../src/utils/startOfDayKey')
+
+test('return midnight of day in UTC', async (t) => {
+
+	const result = startOfDayKey(20200503, 'UTC')
+
+	t.is(result.toISOString(), '2020-05-03T00:00:00.000Z')
+
+})
+
+test('return midnight of day in time zone behind UTC', async (t) => {
+
+	const result = startOfDayKey(20200503, 'America/Los_Angeles')
+
+	t.is(result.toISOString(), '2020-05-03T07:00:00.000Z')
+
+})
\ No newline at end of file
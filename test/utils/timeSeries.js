@@ -0,0 +1,21 @@
+'use strict'
+
+const test = require('ava')
+
+const timeSeries = require('../../src/utils/timeSeries')
+
+test('return options of time field', async (t) => {
+
+	const result = timeSeries.options('created')
+
+	t.is(result.timeField, 'created')
+	t.is(result.metaField, 'domainId')
+	t.is(result.granularity, timeSeries.granularity)
+
+})
+
+test('be disabled by default', async (t) => {
+
+	t.false(timeSeries.enabled)
+
+})
\ No newline at end of file
@@ -0,0 +1,43 @@
+'use strict'
+
+const test = require('ava')
+const uuid = require('uuid').v4
+
+const versions = require('../../src/utils/versions')
+
+test('return initial version', async (t) => {
+
+	const result = await versions.get(uuid())
+
+	t.is(result, 0)
+
+})
+
+test('increase version', async (t) => {
+
+	const id = uuid()
+
+	await versions.bump(id)
+	await versions.bump(id)
+
+	const result = await versions.get(id)
+
+	t.is(result, 2)
+
+})
+
+test('change tag with version', async (t) => {
+
+	const id = uuid()
+
+	const a = await versions.tag([ id ])
+	const b = await versions.tag([ id ])
+
+	await versions.bump(id)
+
+	const c = await versions.tag([ id ])
+
+	t.is(a, b)
+	t.not(a, c)
+
+})
@@ -2,15 +2,19 @@
 
 const test = require('ava')
 
+process.env.ACKEE_TIMEZONE = 'Asia/Tokyo'
+
 const zeroDate = require('../../src/utils/zeroDate')
+const dayKey = require('../../src/utils/dayKey')
 
-test('return date without hours, minutes, seconds and milliseconds', async (t) => {
+test('return midnight of the current day in the reporting time zone', async (t) => {
 
 	const date = zeroDate()
 
-	t.is(date.getHours(), 0)
-	t.is(date.getMinutes(), 0)
-	t.is(date.getSeconds(), 0)
-	t.is(date.getMilliseconds(), 0)
+	t.is(dayKey(date), dayKey())
+	t.true(dayKey(new Date(date.getTime() - 1)) < dayKey())
+	t.is(date.getUTCHours(), 15)
+	t.is(date.getUTCMinutes(), 0)
+	t.is(date.getUTCMilliseconds(), 0)
 
 })
\ No newline at end of file